@@ -223,13 +223,13 @@ void drawWrappedCenteredText(const String& s, uint8_t size){
   }
 }
 
-  void drawAngry(uint32_t now, Eye& L, Eye& R){ outlineEye(L); outlineEye(R); pupil(L); pupil(R); brows(); }
-  void drawLove(uint32_t now, Eye& L, Eye& R){ outlineEye(L); outlineEye(R); pupil(L); pupil(R); heart(30,14,5); heart(98,14,5); }
-  void drawSurprised(uint32_t now, Eye& L, Eye& R){ L.rx=R.rx=14; L.ry=R.ry=14; outlineEye(L); outlineEye(R); oled.drawCircle(64,52,10,SH110X_WHITE); }
+  void drawAngry(uint32_t /*now*/, Eye& L, Eye& R){ outlineEye(L); outlineEye(R); pupil(L); pupil(R); brows(); }
+  void drawLove(uint32_t /*now*/, Eye& L, Eye& R){ outlineEye(L); outlineEye(R); pupil(L); pupil(R); heart(30,14,5); heart(98,14,5); }
+  void drawSurprised(uint32_t /*now*/, Eye& L, Eye& R){ L.rx=R.rx=14; L.ry=R.ry=14; outlineEye(L); outlineEye(R); oled.drawCircle(64,52,10,SH110X_WHITE); }
   void drawTired(uint32_t now, Eye& L, Eye& R){ L.ry=R.ry=8; outlineEye(L); outlineEye(R); pupil(L); pupil(R); zzz(now); }
   void drawConfused(uint32_t now, Eye& L, Eye& R){ outlineEye(L); outlineEye(R); pupil(L); pupil(R); squiggle(64,54, now); }
   void drawLaugh(uint32_t now, Eye& L, Eye& R){ int16_t bob = sin16(now, 300, 2); L.cy+=bob; R.cy+=bob; outlineEye(L); outlineEye(R); openMouth(64, 48, 18); }
-  void drawWink(uint32_t now, bool left, Eye& L, Eye& R){ outlineEye(L); outlineEye(R); pupil(L); pupil(R); if (left) lidClosed(L); else lidClosed(R); }
+  void drawWink(uint32_t /*now*/, bool left, Eye& L, Eye& R){ outlineEye(L); outlineEye(R); pupil(L); pupil(R); if (left) lidClosed(L); else lidClosed(R); }
   void smile(int16_t cx,int16_t cy,int16_t r){ for(int x=-r;x<=r;x++){ int y=(int)(sqrt(max(0,r*r-x*x))*0.5); oled.drawPixel(cx+x, cy+y, SH110X_WHITE);} }
   void sadMouth(int16_t cx,int16_t cy,int16_t r){ for(int x=-r;x<=r;x++){ int y=(int)(-sqrt(max(0,r*r-x*x))*0.5); oled.drawPixel(cx+x, cy+y, SH110X_WHITE);} }
   void openMouth(int16_t cx,int16_t cy,int16_t r){ oled.drawCircle(cx,cy,r,SH110X_WHITE); oled.drawLine(cx-r,cy, cx+r,cy, SH110X_WHITE);}  
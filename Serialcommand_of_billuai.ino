@@ -10,21 +10,22 @@
 // ----------------------
 // 🟢 GLOBAL DEFINITIONS
 // ----------------------
-#define LED_PIN    5
-#define NUM_LEDS   300
+#define DEFAULT_LED_PIN   5     // strip config defaults until CMD:STRIP= saves others
+#define DEFAULT_NUM_LEDS  300
 #define LIGHT_RELAY 26
 #define FAN_RELAY 27
 #define MAX_QUEUE 10
 
-Adafruit_NeoPixel strip(NUM_LEDS, LED_PIN, NEO_GRB + NEO_KHZ800);
+Adafruit_NeoPixel strip;   // length, pin and pixel order set at boot (stripconfig.h)
 Adafruit_SH1106G display(128, 64, &Wire, -1); 
 
 // ----------------------
 // 🟢 GLOBAL VARIABLES
 // ----------------------
-uint16_t activeLEDCount = NUM_LEDS;
+uint16_t numLeds = DEFAULT_NUM_LEDS;   // strip length, fixed at boot
+uint16_t activeLEDCount = DEFAULT_NUM_LEDS;
 uint16_t ledStart = 0;
-uint16_t ledEnd = NUM_LEDS - 1;
+uint16_t ledEnd = DEFAULT_NUM_LEDS - 1;
 uint32_t currentColor = strip.Color(255, 255, 255);
 
 const uint8_t DEFAULT_BRIGHTNESS_PCT = 30;
@@ -72,24 +73,49 @@ uint16_t rainbowHue = 0;
 // ----------------------
 #include "lcd_compat.h"
 #include "Billu_RoboEyes_EmoPack.h"
+#include "governor.h"
+#include "taskqueue.h"
+#include "parallel.h"
+#include "pixelkernels.h"
+#include "indexed.h"
+#include "pixelmap.h"
+#include "render.h"
+#include "layers.h"
+#include "transition.h"
+#include "fastrand.h"
+#include "palette.h"
+#include "matrix.h"
+#include "symmetry.h"
+#include "particles.h"
+#include "loopcache.h"
 #include "utils.h"
 #include "colors.h"
 #include "patterns.h"
 #include "effects.h"
 #include "moods.h"
+#include "zones.h"
+#include "anim.h"
+#include "stripconfig.h"
+#include "idle.h"
 #include "commands.h"
+#include "tasks.h"
 
 // ----------------------
 // 🚀 SETUP + LOOP
 // ----------------------
 void setup() {
   Serial.begin(115200);
+  if (!stripBegin()) {      // no frame[] to render into: say so on the OLED and stop here
+    Eyes_init();
+    lcd.print("No RAM for LEDs");
+    lcd.flush();
+    for (;;) delay(1000);
+  }
   randomSeed(micros());
+  rngSeed(micros());
   Eyes_init();
   brightness = map(brightnessPct, 0, 100, 0, 255);
-  strip.begin();
-  strip.setBrightness(brightness);
-  strip.show();
+  outputsBegin();
 
   pinMode(LIGHT_RELAY, OUTPUT);
   pinMode(FAN_RELAY, OUTPUT);
@@ -97,13 +123,26 @@ void setup() {
   digitalWrite(FAN_RELAY, HIGH);    // Default ON  
 
   lcd.print("Billu Ready!");
+  animBegin();
+  idleBegin();
+  parallelBegin();          // ⚡ render helpers for long strips
+  tasksBegin();             // 🧵 dual-core: Serial + OLED move to their own task
 }
 
 void loop() {
+  if (idleTick()) return;    // 💤 static scene: slept until UART byte / OLED tick
+  govBegin();                // 🎚 frame time for the quality governor
+
+#if DUAL_CORE
+  updateActivePattern();
+  tasksDrainCommands();     // ✅ Commands queued by the UI task
+#else
   handleSerialCommands();   // ✅ Collect new commands
   updateActivePattern(); 
-  Eyes_update();
-  lcd.flush();
+  if (govOledDue()) {
+    Eyes_update();
+    lcd.flush();
+  }
 
   // ✅ Process all queued commands at once
   if (queueStart != queueEnd && !processingCommands) {
@@ -114,18 +153,23 @@ void loop() {
       processCommand(cmd);      
       queueStart = (queueStart + 1) % MAX_QUEUE;
     }
-
-if (!scrollMode) strip.show();
               
     processingCommands = false;
   }
+#endif
 
-if (scrollMode && currentEffect != NONE) {
-  currentEffect = NONE;  // 💀 force kill any effect trying to run
+if (scrollMode && currentEffect != NONE && !layeringEnabled) {
+  currentEffect = NONE;  // 💀 force kill any effect trying to run (single-layer mode)
 }
 
-if (currentEffect != NONE && !scrollMode) {
+beginFrame();
+if (currentEffect != NONE && (!scrollMode || layeringEnabled)) {
   runCurrentEffect();
 }
+  updateAnimation();   // CMD:PLAY frames from LittleFS
 
+  renderZones();   // every zone's effect, into the same frame
+  updateLayers();
+  commitFrame();   // ✅ single push per frame (skipped when nothing changed)
+  govEnd();
 }
@@ -0,0 +1,247 @@
+#pragma once
+// =====================
+// 🎬 ANIMATION PLAYER MODULE
+// =====================
+//
+// Plays host-authored strip animations (GIF-like sequences, POV columns)
+// stored in LittleFS, so long shows run without streaming over serial.
+// Files are uploaded with the LittleFS data uploader into /anim/<name>.ban.
+//
+// File format (.ban, little-endian):
+//   header   16 bytes: "BAN1", u16 pixels per frame, u16 frame count,
+//            u16 frame ms, u8 palette size (0 = 256), 5 reserved (0)
+//   palette  palette size × RGB (3 bytes)
+//   frames   u16 payload bytes, then the payload: 8-bit palette indices,
+//            run-length coded. Control byte c < 0x80: c+1 literal indices
+//            follow; c ≥ 0x80: the next index repeats (c & 0x7F)+1 times.
+//            A 0-byte payload holds the previous frame.
+//
+// The decoder streams: only the palette (1 KB) and a ANIM_BUF_SIZE read
+// buffer stay in RAM, and each frame decodes straight into the framebuffer
+// over the LED range. A file wider than the range is cropped.
+//
+//   CMD:PLAY=<name>[,<loops>[,<speed%>]]   loops 0 = forever (default),
+//                                          speed 100 = authored timing
+//   CMD:PLAY=STOP
+//
+// Host builds read the same files from ANIM_HOST_DIR on disk instead.
+//
+
+#define ANIM_BUF_SIZE   64
+#define ANIM_HEADER     16
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <LittleFS.h>
+typedef File AnimFile;
+
+inline AnimFile animFileOpen(const String& name) {
+  return LittleFS.open("/anim/" + name + ".ban", "r");
+}
+#else
+// File-backed stand-in with the slice of fs::File the player uses
+#include <cstdio>
+#ifndef ANIM_HOST_DIR
+#define ANIM_HOST_DIR "anim/"
+#endif
+
+struct AnimFile {
+  FILE* fp = nullptr;
+  size_t read(uint8_t* buf, size_t n) { return fp ? fread(buf, 1, n, fp) : 0; }
+  bool seek(uint32_t pos) { return fp && fseek(fp, pos, SEEK_SET) == 0; }
+  void close() { if (fp) fclose(fp); fp = nullptr; }
+  explicit operator bool() const { return fp != nullptr; }
+};
+
+inline AnimFile animFileOpen(const String& name) {
+  AnimFile f;
+  f.fp = fopen((String(ANIM_HOST_DIR) + name + ".ban").c_str(), "rb");
+  return f;
+}
+#endif
+
+struct AnimPlayer {
+  AnimFile file;
+  String name;
+  uint16_t len, frames, frameMs;
+  uint32_t framesAt;           // file offset of frame 0
+  uint16_t frame;              // next frame to decode
+  uint16_t loops, loopsDone;   // loops 0 = forever
+  uint16_t speedPct;
+  unsigned long next;          // millis() the next frame is due
+  uint32_t palette[256];
+  uint8_t buf[ANIM_BUF_SIZE];
+  uint8_t bufLen, bufPos;
+  uint16_t payloadLeft;        // bytes of the current frame not yet consumed
+};
+
+AnimPlayer anim;
+bool animPlaying = false;
+bool animFsReady = false;
+
+void animBegin() {
+#if defined(ARDUINO_ARCH_ESP32)
+  animFsReady = LittleFS.begin();
+  if (!animFsReady) Serial.println("⚠️ LittleFS not mounted, CMD:PLAY unavailable");
+#else
+  animFsReady = true;
+#endif
+}
+
+// ======================
+// 📖 STREAM READER
+// ======================
+inline bool animFill() {
+  anim.bufLen = anim.file.read(anim.buf, ANIM_BUF_SIZE);
+  anim.bufPos = 0;
+  return anim.bufLen > 0;
+}
+
+inline bool animByte(uint8_t& b) {
+  if (anim.bufPos >= anim.bufLen && !animFill()) return false;
+  b = anim.buf[anim.bufPos++];
+  return true;
+}
+
+bool animRead(uint8_t* dst, uint16_t n) {
+  for (uint16_t i = 0; i < n; i++) if (!animByte(dst[i])) return false;
+  return true;
+}
+
+bool animRewind() {
+  if (!anim.file.seek(anim.framesAt)) return false;
+  anim.bufLen = anim.bufPos = 0;
+  anim.frame = 0;
+  return true;
+}
+
+// ======================
+// 🎞 FRAME DECODER
+// ======================
+// One frame → frame[ledStart..]; false on a truncated or corrupt file
+bool animDecodeFrame() {
+  uint8_t lo, hi;
+  if (!animByte(lo) || !animByte(hi)) return false;
+  anim.payloadLeft = lo | (hi << 8);
+  if (!anim.payloadLeft) return true;   // hold the previous frame
+
+  uint16_t range = ledEnd - ledStart + 1;
+  uint16_t shown = (anim.len < range) ? anim.len : range;
+  uint32_t* out = drawRange(ledStart, shown);
+  uint16_t px = 0;
+  while (anim.payloadLeft && px < anim.len) {
+    uint8_t c, idx = 0;
+    if (!animByte(c)) return false;
+    anim.payloadLeft--;
+    bool run = c & 0x80;
+    uint16_t count = (c & 0x7F) + 1;
+    for (uint16_t k = 0; k < count; k++) {
+      if (!run || k == 0) {
+        if (!anim.payloadLeft || !animByte(idx)) return false;
+        anim.payloadLeft--;
+      }
+      if (px < shown) out[px] = anim.palette[idx];
+      px++;
+    }
+  }
+  // Skip whatever a malformed frame left over
+  for (uint8_t b; anim.payloadLeft; anim.payloadLeft--) if (!animByte(b)) return false;
+  return px == anim.len;
+}
+
+// ======================
+// ▶️ PLAYBACK
+// ======================
+void animStop() {
+  if (!animPlaying) return;
+  anim.file.close();
+  animPlaying = false;
+  Serial.println("⏹ Animation stopped");
+}
+
+// Open, validate the header, load the palette. Error message on failure.
+bool animStart(const String& name, uint16_t loops, uint16_t speedPct) {
+  animStop();
+  if (!animFsReady) {
+    Serial.println("❗ No filesystem");
+    return false;
+  }
+  anim.file = animFileOpen(name);
+  if (!anim.file) {
+    Serial.println("❗ Animation not found: " + name);
+    return false;
+  }
+  anim.bufLen = anim.bufPos = 0;
+
+  uint8_t h[ANIM_HEADER];
+  if (!animRead(h, ANIM_HEADER) || memcmp(h, "BAN1", 4) != 0) {
+    Serial.println("❗ Not a BAN1 animation: " + name);
+    anim.file.close();
+    return false;
+  }
+  anim.len = h[4] | (h[5] << 8);
+  anim.frames = h[6] | (h[7] << 8);
+  anim.frameMs = h[8] | (h[9] << 8);
+  uint16_t palSize = h[10] ? h[10] : 256;
+
+  memset(anim.palette, 0, sizeof(anim.palette));
+  for (uint16_t i = 0; i < palSize; i++) {
+    uint8_t rgb[3];
+    if (!animRead(rgb, 3)) {
+      Serial.println("❗ Truncated palette: " + name);
+      anim.file.close();
+      return false;
+    }
+    anim.palette[i] = strip.Color(rgb[0], rgb[1], rgb[2]);
+  }
+  if (!anim.len || !anim.frames) {
+    Serial.println("❗ Empty animation: " + name);
+    anim.file.close();
+    return false;
+  }
+
+  anim.framesAt = ANIM_HEADER + palSize * 3;
+  anim.frame = 0;
+  anim.name = name;
+  anim.loops = loops;
+  anim.loopsDone = 0;
+  anim.speedPct = constrain(speedPct, 10, 1000);
+  anim.next = millis();
+  animPlaying = true;
+
+  Serial.print("🎬 Playing "); Serial.print(name);
+  Serial.print(": "); Serial.print(anim.frames); Serial.print(" frames × ");
+  Serial.print(anim.len); Serial.print(" px @ "); Serial.print(anim.frameMs); Serial.println(" ms");
+  return true;
+}
+
+// ======================
+// 🔄 LOOP UPDATER (before commitFrame)
+// ======================
+void updateAnimation() {
+  if (!animPlaying) return;
+  unsigned long now = millis();
+  if ((long)(now - anim.next) < 0) return;
+
+  if (anim.frame >= anim.frames) {
+    if (anim.loops && ++anim.loopsDone >= anim.loops) {
+      animStop();
+      return;
+    }
+    if (!animRewind()) {
+      Serial.println("❗ Animation seek failed");
+      animStop();
+      return;
+    }
+  }
+  if (!animDecodeFrame()) {
+    Serial.println("❗ Corrupt animation frame " + String(anim.frame) + " in " + anim.name);
+    animStop();
+    return;
+  }
+  anim.frame++;
+
+  // Authored timing, scaled; catch up without bursting after a stall
+  uint32_t step = (uint32_t)anim.frameMs * 100 / anim.speedPct;
+  anim.next += step ? step : 1;
+  if ((long)(now - anim.next) > (long)step) anim.next = now + step;
+}
@@ -6,8 +6,10 @@
 // ======================
 // 🌈 MULTICOLOR STORAGE (for patterns & effects)
 // ======================
-uint8_t multiColors[10][3];   // actual allocation
+uint8_t multiColors[MAX_MULTI_COLORS][3];   // actual allocation
 int multiColorCount = 0;
+uint8_t multiStopPos[MAX_MULTI_COLORS];     // only used when multiStopPosSet
+bool multiStopPosSet = false;
 
 
 void renderMultiColorsBlock();
@@ -104,21 +106,29 @@ void handleRGBN(String cmd) {
 
     // reset
     multiColorCount = 0;
+    multiStopPosSet = true;   // cleared below if any entry lacks an @pos
 
     int start = 0;
-    while (start < rgbValues.length() && multiColorCount < 10) {
+    while (start < (int)rgbValues.length() && multiColorCount < MAX_MULTI_COLORS) {
         int comma1 = rgbValues.indexOf(',', start);
         int comma2 = rgbValues.indexOf(',', comma1 + 1);
         int semi = rgbValues.indexOf(';', comma2 + 1);
         if (semi == -1) semi = rgbValues.length();
 
+        // Optional stop position: R,G,B@pos
+        String blue = rgbValues.substring(comma2 + 1, semi);
+        int at = blue.indexOf('@');
+        if (at >= 0) multiStopPos[multiColorCount] = constrain(blue.substring(at + 1).toInt(), 0, 255);
+        else multiStopPosSet = false;
+
         multiColors[multiColorCount][0] = rgbValues.substring(start, comma1).toInt();
         multiColors[multiColorCount][1] = rgbValues.substring(comma1 + 1, comma2).toInt();
-        multiColors[multiColorCount][2] = rgbValues.substring(comma2 + 1, semi).toInt();
+        multiColors[multiColorCount][2] = blue.toInt();
 
         multiColorCount++;
         start = semi + 1;
     }
+    paletteFromMultiColors();
 
     // draw
     renderMultiColorsBlock();
@@ -153,10 +163,11 @@ void handleCOLORN(String cmd) {
   Serial.println("🧪 handleCOLORN received: " + allNames);
 
   multiColorCount = 0;
+  multiStopPosSet = true;   // cleared below if any name lacks an @pos
   String name = "";
   int start = 0;
 
-  while (start < allNames.length()) {
+  while (start < (int)allNames.length() && multiColorCount < MAX_MULTI_COLORS) {
     int comma = allNames.indexOf(',', start);
     if (comma == -1) comma = allNames.length();
 
@@ -164,6 +175,16 @@ void handleCOLORN(String cmd) {
     name.trim();  // ✅ Extra safety
     Serial.println("🔍 Parsed color: " + name);
 
+    // Optional stop position: name@pos
+    int at = name.indexOf('@');
+    if (at >= 0) {
+      multiStopPos[multiColorCount] = constrain(name.substring(at + 1).toInt(), 0, 255);
+      name = name.substring(0, at);
+      name.trim();
+    } else {
+      multiStopPosSet = false;
+    }
+
     uint8_t r, g, b;
     if (lookupColor(name, r, g, b)) {
       multiColors[multiColorCount][0] = r;
@@ -178,6 +199,7 @@ void handleCOLORN(String cmd) {
     start = comma + 1;
   }
 
+  paletteFromMultiColors();
   refreshCurrentPattern();
   Serial.print("🎨 RGBN applied with ");
   Serial.print(multiColorCount);
@@ -196,8 +218,8 @@ void addColorToMulti(String name) {
         return;
     }
 
-    if (multiColorCount >= 10) {
-        Serial.println("⚠️ Max color limit reached (10)");
+    if (multiColorCount >= MAX_MULTI_COLORS) {
+        Serial.println("⚠️ Max color limit reached (" + String(MAX_MULTI_COLORS) + ")");
         return;
     }
 
@@ -214,6 +236,8 @@ void addColorToMulti(String name) {
     multiColors[multiColorCount][1] = g;
     multiColors[multiColorCount][2] = b;
     multiColorCount++;
+    multiStopPosSet = false;   // explicit positions no longer line up
+    paletteFromMultiColors();
 
     Serial.print("✅ Color added: "); Serial.println(name);
 
@@ -258,6 +282,9 @@ void removeColorFromMulti(String name) {
         return;
     }
 
+    multiStopPosSet = false;
+    paletteFromMultiColors();
+
     Serial.print("✅ Color removed: "); Serial.println(name);
 
     if (wasScrolling) { scrollMode = true; }
@@ -284,12 +311,11 @@ void renderMultiColorsBlock() {
     for (int c = 0; c < multiColorCount; c++) {
         int count = ledsPerColor + (c < extraLEDs ? 1 : 0);
         for (int i = 0; i < count && ledIndex <= ledEnd; i++) {
-            strip.setPixelColor(
+            setPixel(
               ledIndex,
               strip.Color(multiColors[c][0], multiColors[c][1], multiColors[c][2])
             );
             ledIndex++;
         }
     }
-    strip.show();
 }
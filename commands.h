@@ -12,28 +12,8 @@ bool processingCommands = false;
 void stopScrollMode();
 
 String effectName(EffectType e) {
-    switch (e) {
-        case WAVE: return "wave";
-        case BLINK: return "blink";
-        case CHASE: return "chase";
-        case PULSE: return "pulse";
-        case RAINBOW: return "rainbow";
-        case CENTER_WAVE: return "center_wave";
-        case BOUNCE_WAVE: return "bounce_wave";
-        case TWINKLE: return "twinkle";
-        case PARTY_FLASH: return "party_flash";
-        case FIRE_GLOW: return "fire_glow";
-        case THUNDER: return "thunder";
-        case FADE_LOOP: return "fade_loop";
-        case HEARTBEAT: return "heartbeat";
-        case DRIZZLE: return "drizzle";
-        case FLASH: return "flash";
-        case COLOR_COMET: return "color_comet";
-        case SOFT_GLOW: return "soft_glow";
-        case STAR_RAIN: return "star_rain";
-        case FIREWORKS: return "fireworks";
-        default: return "none";
-    }
+    EffectInfo* info = effectInfo(e);
+    return info ? info->name : "none";
 }
 
 MoodType resolveMoodType(String name) {
@@ -85,8 +65,59 @@ void handleSerialCommands() {
 // ✅ Processor
 void processCommand(String cmd) {
 
-    // Eyes (OLED) command path first
+    // Eyes (OLED) command path first (dual-core: already taken by the UI task)
+#if !DUAL_CORE
     if (Eyes_tryHandleCommand(cmd)) return;
+#endif
+
+    // Scene changes crossfade from what's on the LEDs now (CMD:FADE=ms)
+    if (cmd.startsWith("CMD:EFFECT=") || cmd.startsWith("CMD:COLOR") || cmd.startsWith("CMD:RGB") ||
+        cmd.startsWith("CMD:PATTERN=") || cmd.startsWith("CMD:MOOD=") || cmd.startsWith("CMD:LED=") ||
+        cmd.startsWith("CMD:PLAY=") || cmd == "CMD:STOP" || cmd == "CMD:CONTINUE") {
+        transitionBegin();
+        if (!cmd.startsWith("CMD:PLAY=") && zoneActive < 0) animStop();   // any other scene replaces the animation
+    }
+
+    // =====================
+    // 🗺 ZONE-ADDRESSED COMMANDS
+    // =====================
+    // CMD@<n>:<command> → run <command> with zone n's context swapped in
+    if (cmd.startsWith("CMD@")) {
+        int colon = cmd.indexOf(':');
+        int n = (colon > 4) ? cmd.substring(4, colon).toInt() : 0;
+        String inner = "CMD" + cmd.substring(colon);
+        if (zoneActive >= 0 || !zoneValid(n)) {
+            Serial.println("❗ Unknown zone: " + cmd);
+            statusShow("❌ No such zone", 900);
+            return;
+        }
+        // Whole-strip commands stay on the main strip
+        if (inner.startsWith("CMD:ZONE=") || inner.startsWith("CMD:LEDRANGE=") ||
+            inner.startsWith("CMD:REGION=") || inner.startsWith("CMD:NUMLEDS=") ||
+            inner.startsWith("CMD:LEDINDEX=") || inner.startsWith("CMD:LAYER=") ||
+            inner.startsWith("CMD:GAMMA=") || inner.startsWith("CMD:WHITEBALANCE=") ||
+            inner.startsWith("CMD:LEDIDLE=") || inner.startsWith("CMD:LOOPCACHE=") ||
+            inner.startsWith("CMD:PLAY=") || inner.startsWith("CMD:STRIP=") ||
+            inner.startsWith("CMD:OUTPUT=") || inner.startsWith("CMD:MAP=") ||
+            inner.startsWith("CMD:MATRIX=") || inner.startsWith("CMD:SYMMETRY=") ||
+            inner.startsWith("CMD:GOVERNOR=") || inner.startsWith("CMD:PARALLEL=")) {
+            Serial.println("❗ Not a zone command: " + inner);
+            statusShow("❌ Not per-zone", 900);
+            return;
+        }
+        // Scroll is stepped and sampled for the main strip only (patterns.h)
+        String pat = inner.startsWith("CMD:PATTERN=") ? inner.substring(12) : "";
+        pat.toLowerCase();
+        if (pat == "scroll" || inner.startsWith("CMD:SCROLL=")) {
+            Serial.println("❗ Scroll is main-strip only: " + inner);
+            statusShow("❌ No zone scroll", 900);
+            return;
+        }
+        zoneEnter(n);
+        processCommand(inner);
+        zoneLeave();
+        return;
+    }
 
     // =====================
     // ⏹ STOP / ▶ CONTINUE
@@ -139,32 +170,18 @@ void processCommand(String cmd) {
     // ✨ Effects (with status)
     // =====================
     if (cmd.startsWith("CMD:EFFECT=")) {
-        stopScrollMode();
+        if (!layeringEnabled) stopScrollMode();   // layered: scroll stays under the effect
         String effect = cmd.substring(11);
         customSpeed = false;
         resetEffectState();
 
-        if (effect == "wave")               { currentEffect = WAVE; effectSpeed = 30; shimmerActive = true; }
-        else if (effect == "center_wave")   { currentEffect = CENTER_WAVE; effectSpeed = 30; shimmerActive = true; }
-        else if (effect == "bounce_wave")   { currentEffect = BOUNCE_WAVE; effectSpeed = 30; shimmerActive = true; }
-        else if (effect == "blink")         { currentEffect = BLINK; blinkCounter = 0; blinkOn = false; effectSpeed = 300; shimmerActive = false; }
-        else if (effect == "chase")         { currentEffect = CHASE; chaseIndex = 0; chaseRep = 0; effectSpeed = 60; shimmerActive = false; }
-        else if (effect == "pulse")         { currentEffect = PULSE; pulseBrightness = 0; pulseUp = true; effectSpeed = 20; shimmerActive = false; }
-        else if (effect == "rainbow")       { currentEffect = RAINBOW; rainbowHue = 0; effectSpeed = 20; shimmerActive = false; }
-        else if (effect == "strobe")        { currentEffect = STROBE; effectSpeed = 40; shimmerActive = false; }
-        else if (effect == "twinkle")       { currentEffect = TWINKLE; effectSpeed = 60; shimmerActive = false; }
-        else if (effect == "party_flash")   { currentEffect = PARTY_FLASH; effectSpeed = 30; shimmerActive = false; }
-        else if (effect == "fire_glow")     { currentEffect = FIRE_GLOW; effectSpeed = 40; shimmerActive = false; }
-        else if (effect == "color_comet")   { currentEffect = COLOR_COMET; waveIndex = 0; effectSpeed = 20; shimmerActive = false; }
-        else if (effect == "thunder")       { currentEffect = THUNDER; effectSpeed = 30; shimmerActive = false; }
-        else if (effect == "fade_loop")     { currentEffect = FADE_LOOP; fadeHue = 0; effectSpeed = 20; shimmerActive = false; }
-        else if (effect == "soft_glow")     { currentEffect = SOFT_GLOW; effectSpeed = 20; shimmerActive = false; }
-        else if (effect == "heartbeat")     { currentEffect = HEARTBEAT; effectSpeed = 25; shimmerActive = false; }
-        else if (effect == "star_rain")     { currentEffect = STAR_RAIN; effectSpeed = 40; shimmerActive = false; }
-        else if (effect == "fireworks")     { currentEffect = FIREWORKS; effectSpeed = 30; shimmerActive = false; }
-        else if (effect == "drizzle")       { currentEffect = DRIZZLE; effectSpeed = 40; shimmerActive = false; }
-        else if (effect == "flash")         { currentEffect = FLASH; effectSpeed = 60; shimmerActive = false; }
-        else if (effect == "rain")          { currentEffect = RAIN; effectSpeed = 50; shimmerActive = false; }
+        // resetEffectState() above already zeroed the per-effect counters
+        EffectInfo* info = effectByName(effect);
+        if (info) {
+            currentEffect = info->type;
+            effectSpeed = info->speed;
+            shimmerActive = info->shimmer;
+        }
 
         lastEffect = currentEffect;
         showEffect(effect);     // <-- OLED status line
@@ -179,18 +196,10 @@ void processCommand(String cmd) {
         ledState = true;
         stopScrollMode();
         currentEffect = NONE;        // don’t fight with effects
+        setEffectLevel(255);         // undo any PULSE/SOFT_GLOW dimming
 
-        if (multiColorCount > 0) {
-            // If a basePattern was set earlier, re-apply it; else draw blocks
-            if (basePattern == "stripe")        patternStripe();
-            else if (basePattern == "gradient") patternGradient();
-            else if (basePattern == "split")    patternSplit();
-            else                                renderMultiColorsBlock();
-        } else {
-            // Single-color mode
-            compositeMode = false;   // ensure legacy 2-color mode is off
-            fillAll(currentColor);
-        }
+        if (multiColorCount == 0) compositeMode = false;   // single-color mode: legacy 2-color mode off
+        redrawBase();
 
         showLED(true);               // <-- OLED status line
         return;
@@ -199,8 +208,8 @@ void processCommand(String cmd) {
     if (cmd == "CMD:LED=OFF") { 
         ledState = false; 
         currentEffect = NONE; 
-        strip.clear(); 
-        strip.show(); 
+        if (zoneActive >= 0) clearRange(ledStart, ledEnd);   // just this zone
+        else clearPixels(); 
         showLED(false);              // <-- OLED status line
         return; 
     }
@@ -209,8 +218,7 @@ void processCommand(String cmd) {
     // 🖥 LCD MESSAGES
     // =====================
     if (cmd.startsWith("CMD:LCD=")) { 
-        lcd.clear(); 
-        lcd.print(cmd.substring(8)); 
+        lcdMessage(cmd.substring(8)); 
         return; 
     }
 
@@ -226,25 +234,55 @@ void processCommand(String cmd) {
     // =====================
     // 🔆 BRIGHTNESS
     // =====================
+    if (cmd.startsWith("CMD:BRIGHTNESS=") && zoneActive >= 0) {
+        uint8_t pct = constrain(cmd.substring(15).toInt(), 0, 100);
+        zoneSetBrightness(pct);
+        Serial.print("🔆 Zone "); Serial.print(zoneActive + 1);
+        Serial.print(" brightness: "); Serial.println(pct);
+        showBrightness(pct);
+        return;
+    }
     if (cmd.startsWith("CMD:BRIGHTNESS=")) {
         brightnessPct = constrain(cmd.substring(15).toInt(), 0, 100);
         brightness = map(brightnessPct, 0, 100, 0, 255);
-        strip.setBrightness(brightness);
-        if (ledState && !scrollMode) {
-            if (multiColorCount > 0) {
-                if (basePattern == "stripe")        patternStripe();
-                else if (basePattern == "gradient") patternGradient();
-                else if (basePattern == "split")    patternSplit();
-                else                                renderMultiColorsBlock();
-            } else {
-                fillAll(currentColor);
-            }
-        }
+        invalidateOutputStage();   // frame[] is untouched; only the output tables change
         Serial.print("🔆 Brightness set: "); Serial.println(brightnessPct);
         showBrightness(brightnessPct);     // <-- OLED status line
         return;
     }
 
+    // CMD:GAMMA=ON|OFF → perceptual output curve
+    if (cmd.startsWith("CMD:GAMMA=")) {
+        String v = cmd.substring(10);
+        v.toUpperCase();
+        if (v != "ON" && v != "OFF") {
+            Serial.println("❗ Gamma: ON or OFF: " + v);
+            statusShow("❌ Gamma", 900);
+            return;
+        }
+        gammaEnabled = (v == "ON");
+        invalidateOutputStage();
+        Serial.print("🎚 Gamma: "); Serial.println(gammaEnabled ? "ON" : "OFF");
+        statusShow(gammaEnabled ? "Gamma ON" : "Gamma OFF", 900);
+        return;
+    }
+
+    // CMD:WHITEBALANCE=R,G,B → per-channel gain 0–255 (255,255,255 = neutral)
+    if (cmd.startsWith("CMD:WHITEBALANCE=")) {
+        String p = cmd.substring(17);
+        int c1 = p.indexOf(','), c2 = p.indexOf(',', c1 + 1);
+        whiteBalance[0] = constrain(p.substring(0, c1).toInt(), 0, 255);
+        whiteBalance[1] = constrain(p.substring(c1 + 1, c2).toInt(), 0, 255);
+        whiteBalance[2] = constrain(p.substring(c2 + 1).toInt(), 0, 255);
+        invalidateOutputStage();
+        Serial.print("⚖️ White balance: ");
+        Serial.print(whiteBalance[0]); Serial.print(", ");
+        Serial.print(whiteBalance[1]); Serial.print(", ");
+        Serial.println(whiteBalance[2]);
+        statusShow("White balance set", 900);
+        return;
+    }
+
     // =====================
     // 🎯 LED CONTROL
     // =====================
@@ -252,57 +290,174 @@ void processCommand(String cmd) {
         int i = cmd.substring(13).toInt();
         if (i >= 0 && i < activeLEDCount) {
             currentEffect = NONE; 
-            strip.clear(); 
-            strip.setPixelColor(i, currentColor); 
-            strip.show();
+            clearPixels(); 
+            setPixel(i, currentColor); 
             showLedIndex(i);              // <-- OLED status line
         }
         return;
     }
 
     if (cmd.startsWith("CMD:NUMLEDS=")) {
-        strip.clear(); strip.show();
-        activeLEDCount = constrain(cmd.substring(12).toInt(), 0, NUM_LEDS);
+        clearOutsideZones(ledStart, ledEnd);   // zones keep their pixels
+        activeLEDCount = constrain(cmd.substring(12).toInt(), 0, numLeds);
         ledStart = 0;
         ledEnd = activeLEDCount > 0 ? activeLEDCount - 1 : 0;
+        clearOutsideZones(ledStart, ledEnd);
         Serial.print("Active LEDs: "); Serial.println(activeLEDCount);
 
-        if (ledState && !scrollMode) {
-            if (multiColorCount > 0) {
-                if (basePattern == "stripe")        patternStripe();
-                else if (basePattern == "gradient") patternGradient();
-                else if (basePattern == "split")    patternSplit();
-                else                                renderMultiColorsBlock();
-            } else {
-                fillAll(currentColor);
+        if (ledState && !scrollMode) mainRedrawBase();
+
+        showNumLeds(activeLEDCount);       // <-- OLED status line
+        return;
+    }
+
+    // CMD:STRIP=<leds>,<pin>,<order> | SHOW → physical strip, saved, applied on reboot
+    if (cmd.startsWith("CMD:STRIP=")) {
+        String args = cmd.substring(10);
+        args.toUpperCase();
+        if (args == "SHOW") { stripConfigPrint(); return; }
+        int c1 = args.indexOf(',');
+        int c2 = (c1 >= 0) ? args.indexOf(',', c1 + 1) : -1;
+        StripConfig c = outputConfig[0];
+        c.leds = args.substring(0, c1 >= 0 ? c1 : args.length()).toInt();
+        if (c1 >= 0) c.pin = args.substring(c1 + 1, c2 >= 0 ? c2 : args.length()).toInt();
+        if (c2 >= 0 && !pixelOrderParse(args.substring(c2 + 1), c.order)) c.order = 0;
+        if (!stripConfigValid(c)) {
+            Serial.print("❗ Bad strip config (1-"); Serial.print(STRIP_MAX_LEDS);
+            Serial.println(" LEDs, order GRB|RGB|BRG|RBG|GBR|BGR): " + args);
+            statusShow("❌ Strip config", 900);
+            return;
+        }
+        stripConfigSave(0, c);
+        Serial.print("📏 Saved: "); Serial.print(c.leds); Serial.print(" LEDs on pin ");
+        Serial.print(c.pin); Serial.print(", "); Serial.print(pixelOrderName(c.order));
+        Serial.println(", rebooting");
+        statusShow("Strip " + String(c.leds) + ", reboot", 1000);
+#if defined(ARDUINO_ARCH_ESP32)
+        Serial.flush();
+        ESP.restart();
+#endif
+        return;
+    }
+
+    // CMD:OUTPUT=<n>,<leds>,<pin>,<order> | <n>,OFF → extra output 1..3, applied on reboot
+    if (cmd.startsWith("CMD:OUTPUT=")) {
+        String args = cmd.substring(11);
+        args.toUpperCase();
+        int c1 = args.indexOf(',');
+        int c2 = (c1 >= 0) ? args.indexOf(',', c1 + 1) : -1;
+        int c3 = (c2 >= 0) ? args.indexOf(',', c2 + 1) : -1;
+        uint8_t o = args.substring(0, c1 >= 0 ? c1 : args.length()).toInt();
+        if (c1 < 0 || o < 1 || o >= PIXMAP_MAX_OUTPUTS) {
+            Serial.println("❗ Output must be 1-" + String(PIXMAP_MAX_OUTPUTS - 1) + ": " + args);
+            statusShow("❌ Output", 900);
+            return;
+        }
+        StripConfig c = { 0, 0, NEO_GRB };
+        if (args.substring(c1 + 1) != "OFF") {
+            c.leds = args.substring(c1 + 1, c2 >= 0 ? c2 : args.length()).toInt();
+            if (c2 >= 0) c.pin = args.substring(c2 + 1, c3 >= 0 ? c3 : args.length()).toInt();
+            if (c3 >= 0 && !pixelOrderParse(args.substring(c3 + 1), c.order)) c.order = 0;
+            if (c2 < 0 || !stripConfigValid(c)) {
+                Serial.println("❗ Bad output config (leds,pin[,order]): " + args);
+                statusShow("❌ Output config", 900);
+                return;
             }
         }
+        stripConfigSave(o, c);
+        Serial.print("📏 Output "); Serial.print(o);
+        Serial.println(c.leds ? " saved, rebooting" : " off, rebooting");
+        statusShow("Output " + String(o) + ", reboot", 1000);
+#if defined(ARDUINO_ARCH_ESP32)
+        Serial.flush();
+        ESP.restart();
+#endif
+        return;
+    }
 
-        showNumLeds(activeLEDCount);       // <-- OLED status line
+    // CMD:MAP=ADD,out,phys,len[,R] | SERP,out,width,rows[,phys] | CLEAR | SHOW | SAVE
+    if (cmd.startsWith("CMD:MAP=")) {
+        String args = cmd.substring(8);
+        args.toUpperCase();
+        int c1 = args.indexOf(',');
+        String op = (c1 >= 0) ? args.substring(0, c1) : args;
+        int v[4] = { -1, -1, -1, -1 };
+        bool reversed = false;
+        for (uint8_t k = 0; k < 4 && c1 >= 0; k++) {
+            int c2 = args.indexOf(',', c1 + 1);
+            String f = args.substring(c1 + 1, c2 >= 0 ? c2 : args.length());
+            if (f == "R") reversed = true;
+            else v[k] = f.toInt();
+            c1 = c2;
+        }
+        uint16_t lens[PIXMAP_MAX_OUTPUTS];
+        outputLengths(lens);
+
+        if (op == "SHOW") {
+            stripConfigPrint();
+            mapPrint(mapRuns, mapRunCount);
+            if (mapEditCount) {
+                Serial.print("🗺 Edit list, "); Serial.print(mapLength(mapEdit, mapEditCount));
+                Serial.println(" logical LEDs:");
+                mapPrint(mapEdit, mapEditCount);
+            }
+            return;
+        }
+        if (op == "CLEAR") {
+            mapEditCount = 0;
+            Serial.println("🗺 Map edit list cleared (SAVE = plain strip)");
+            statusShow("Map cleared", 900);
+            return;
+        }
+        if (op == "SAVE") {
+            if (mapEditCount && !mapValid(mapEdit, mapEditCount, lens, STRIP_MAX_LEDS)) {
+                Serial.println("❗ Map doesn't fit the outputs or exceeds " + String(STRIP_MAX_LEDS) + " LEDs");
+                statusShow("❌ Map", 900);
+                return;
+            }
+            pixelMapSave(mapEdit, mapEditCount);
+            Serial.println("🗺 Map saved, rebooting");
+            statusShow("Map saved, reboot", 1000);
+#if defined(ARDUINO_ARCH_ESP32)
+            Serial.flush();
+            ESP.restart();
+#endif
+            return;
+        }
+
+        bool ok = false;
+        if (op == "ADD" && v[0] >= 0 && v[1] >= 0 && v[2] > 0) {
+            ok = mapAppend(mapEdit, mapEditCount, v[0], v[1], v[2], reversed);
+        } else if (op == "SERP" && v[0] >= 0 && v[1] > 0 && v[2] > 0) {
+            ok = mapSerpentine(mapEdit, mapEditCount, v[0], v[1], v[2], v[3] > 0 ? v[3] : 0);
+        }
+        if (!ok) {
+            Serial.println("❗ Bad map command or edit list full: " + args);
+            statusShow("❌ Map", 900);
+            return;
+        }
+        Serial.print("🗺 Map edit: "); Serial.print(mapEditCount); Serial.print(" runs, ");
+        Serial.print(mapLength(mapEdit, mapEditCount)); Serial.println(" logical LEDs");
+        if (!mapValid(mapEdit, mapEditCount, lens, STRIP_MAX_LEDS)) Serial.println("⚠️ Doesn't fit the outputs yet");
+        statusShow("Map: " + String(mapLength(mapEdit, mapEditCount)) + " LEDs", 900);
         return;
     }
 
     if (cmd.startsWith("CMD:LEDRANGE=")) {
-        strip.clear(); strip.show();
         String p = cmd.substring(13);
         int s = p.substring(0, p.indexOf(',')).toInt();
         int e = p.substring(p.indexOf(',') + 1).toInt();
-        s = constrain(s, 0, NUM_LEDS - 1);
-        e = constrain(e, 0, NUM_LEDS - 1);
+        s = constrain(s, 0, numLeds - 1);
+        e = constrain(e, 0, numLeds - 1);
         if (s <= e) {
+            clearOutsideZones(ledStart, ledEnd);   // zones keep their pixels
             ledStart = s;
             ledEnd = e;
             activeLEDCount = e - s + 1;
+            clearOutsideZones(ledStart, ledEnd);
             Serial.print("LED Range: "); Serial.print(ledStart); Serial.print(" to "); Serial.println(ledEnd);
 
-            if (ledState && !scrollMode) {
-                if (basePattern == "stripe")        patternStripe();
-                else if (basePattern == "gradient") patternGradient();
-                else if (basePattern == "split")    patternSplit();
-                else                                renderMultiColorsBlock();
-            } else {
-                fillAll(currentColor);
-            }
+            if (ledState && !scrollMode) mainRedrawBase();
 
             statusShow("Range: " + String(s) + "–" + String(e), 900);   // <-- OLED status line
         }
@@ -385,36 +540,350 @@ void processCommand(String cmd) {
         return;
     }
 
+    // CMD:SCROLL=<pixels per step, may be fractional or negative>[,<ms per step>]
+    // CMD:SCROLL=PINGPONG | WRAP
+    if (cmd.startsWith("CMD:SCROLL=")) {
+        String args = cmd.substring(11);
+        args.toUpperCase();
+        if (args == "PINGPONG" || args == "WRAP") {
+            scrollPingPong = (args == "PINGPONG");
+            Serial.println(scrollPingPong ? "🔁 Scroll: ping-pong" : "🔁 Scroll: wrap");
+            statusShow(scrollPingPong ? "Scroll: ping-pong" : "Scroll: wrap", 900);
+            return;
+        }
+        int c1 = args.indexOf(',');
+        float step = (c1 >= 0 ? args.substring(0, c1) : args).toFloat();
+        scrollStep = (int16_t)constrain(step * 256.0f, -32000.0f, 32000.0f);
+        if (c1 >= 0) patternSpeed = constrain(args.substring(c1 + 1).toInt(), 1, 1000);
+        Serial.print("🔁 Scroll step: "); Serial.print(step);
+        Serial.print(" px / "); Serial.print(patternSpeed); Serial.println(" ms");
+        statusShow("Scroll: " + String(step) + " px", 900);
+        return;
+    }
+
+    // CMD:PLAY=<name>[,loops[,speed%]] | STOP → animation file from LittleFS
+    if (cmd.startsWith("CMD:PLAY=")) {
+        String args = cmd.substring(9);
+        if (args == "STOP") {
+            animStop();
+            statusShow("Animation stopped", 900);
+            return;
+        }
+        int c1 = args.indexOf(',');
+        int c2 = (c1 >= 0) ? args.indexOf(',', c1 + 1) : -1;
+        String name = (c1 >= 0) ? args.substring(0, c1) : args;
+        uint16_t loops = (c1 >= 0) ? args.substring(c1 + 1, c2 >= 0 ? c2 : args.length()).toInt() : 0;
+        uint16_t speed = (c2 >= 0) ? args.substring(c2 + 1).toInt() : 100;
+
+        if (!animStart(name, loops, speed)) {
+            statusShow("❌ Play " + name, 900);
+            return;
+        }
+        currentEffect = NONE;
+        if (scrollMode) stopScrollMode();
+        ledState = true;
+        statusShow("Play " + name, 1000);
+        return;
+    }
+
+    // CMD:LEDIDLE=ON|OFF|STATS → static-scene fast path and its telemetry
+    if (cmd.startsWith("CMD:LEDIDLE=")) {
+        String v = cmd.substring(12);
+        v.toUpperCase();
+        if (v == "STATS") { idlePrintStats(); return; }
+        if (v != "ON" && v != "OFF") {
+            Serial.println("❗ Idle: ON, OFF or STATS: " + v);
+            statusShow("❌ Idle", 900);
+            return;
+        }
+        idleEnabled = (v == "ON");
+        Serial.println(idleEnabled ? "💤 Idle fast path ON" : "💤 Idle fast path OFF");
+        statusShow(idleEnabled ? "Idle ON" : "Idle OFF", 900);
+        return;
+    }
+
+    // CMD:GOVERNOR=ON|OFF|STATS|<budget ms> → trade detail for a steady frame rate
+    if (cmd.startsWith("CMD:GOVERNOR=")) {
+        String v = cmd.substring(13);
+        v.toUpperCase();
+        if (v == "ON" || v == "OFF") {
+            govEnabled = (v == "ON");
+            if (!govEnabled) govLevel = 0;   // full detail while off
+            statusShow(govEnabled ? "Governor ON" : "Governor OFF", 900);
+        } else if (v != "STATS") {
+            int ms = v.toInt();
+            if (ms <= 0) {
+                Serial.println("❗ Governor: ON, OFF, STATS or a budget in ms: " + v);
+                statusShow("❌ Governor", 900);
+                return;
+            }
+            govBudgetUs = (uint32_t)constrain(ms, 2, 1000) * 1000;
+            statusShow("Budget " + String(ms) + " ms", 900);
+        }
+        govPrintStats();
+        return;
+    }
+
+    // CMD:PARALLEL=ON|OFF|STATS|<min leds> → split long effect renders across cores
+    if (cmd.startsWith("CMD:PARALLEL=")) {
+        String v = cmd.substring(13);
+        v.toUpperCase();
+        if (v == "ON" || v == "OFF") {
+            parEnabled = (v == "ON");
+            statusShow(parEnabled ? "Parallel ON" : "Parallel OFF", 900);
+        } else if (v != "STATS") {
+            int n = v.toInt();
+            if (n <= 0) {
+                Serial.println("❗ Parallel: ON, OFF, STATS or a minimum LED count: " + v);
+                statusShow("❌ Parallel", 900);
+                return;
+            }
+            parMinLeds = constrain(n, 2, STRIP_MAX_LEDS);
+            statusShow("Parallel from " + String(parMinLeds), 900);
+        }
+        parallelPrint();
+        return;
+    }
+
+    // CMD:LOOPCACHE=ON|OFF|STATS → frame cache for periodic effects
+    if (cmd.startsWith("CMD:LOOPCACHE=")) {
+        String v = cmd.substring(14);
+        v.toUpperCase();
+        if (v == "ON" || v == "OFF") {
+            loopCacheEnabled = (v == "ON");
+            if (!loopCacheEnabled) {
+                loopCacheFree(mainEffectState.loop);
+                for (uint8_t k = 0; k < MAX_ZONES; k++) loopCacheFree(zones[k].state.loop);
+            }
+            statusShow(loopCacheEnabled ? "Loop cache ON" : "Loop cache OFF", 900);
+        } else if (v != "STATS") {
+            Serial.println("❗ Loop cache: ON, OFF or STATS: " + v);
+            statusShow("❌ Loop cache", 900);
+            return;
+        }
+        loopCachePrintStats();
+        return;
+    }
+
+    // CMD:KEYFRAMES=<effect>,<n> → render every nth tick, interpolate in between
+    if (cmd.startsWith("CMD:KEYFRAMES=")) {
+        String args = cmd.substring(14);
+        args.toLowerCase();
+        int c1 = args.indexOf(',');
+        EffectInfo* info = (c1 > 0) ? effectByName(args.substring(0, c1)) : nullptr;
+        if (!info || !info->interpolable) {
+            Serial.println("❗ CMD:KEYFRAMES needs an interpolable effect: wave, center_wave, bounce_wave, rainbow, fade_loop, fireworks");
+            statusShow("❌ Keyframes", 900);
+            return;
+        }
+        info->keyframes = constrain(args.substring(c1 + 1).toInt(), 1, 8);
+        Serial.print("🎞 Keyframes "); Serial.print(info->name);
+        Serial.print(": every "); Serial.println(info->keyframes);
+        statusShow(String(info->name) + " keys: " + String(info->keyframes), 900);
+        return;
+    }
+
+    // CMD:FADE=ms → crossfade length for scene changes (0 = instant)
+    if (cmd.startsWith("CMD:FADE=")) {
+        fadeMs = constrain(cmd.substring(9).toInt(), 0, 10000);
+        Serial.print("🌫 Fade: "); Serial.print(fadeMs); Serial.println(" ms");
+        statusShow("Fade: " + String(fadeMs) + " ms", 900);
+        return;
+    }
+
+    // =====================
+    // 🧅 LAYERS
+    // =====================
+    // CMD:LAYER=ON|OFF
+    // CMD:LAYER=<base|effect|overlay>,<replace|add|max|multiply>[,opacity]
+    if (cmd.startsWith("CMD:LAYER=")) {
+        String args = cmd.substring(10);
+        args.toLowerCase();
+        if (args == "on" || args == "off") {
+            setLayering(args == "on");
+            Serial.println(layeringEnabled ? "🧅 Layers ON" : "🧅 Layers OFF");
+            statusShow(layeringEnabled ? "Layers ON" : "Layers OFF", 900);
+            return;
+        }
+
+        int c1 = args.indexOf(','), c2 = args.indexOf(',', c1 + 1);
+        String name = args.substring(0, c1);
+        String mode = (c2 >= 0) ? args.substring(c1 + 1, c2) : args.substring(c1 + 1);
+        name.trim(); mode.trim();
+
+        int id = (name == "base") ? LAYER_BASE : (name == "effect") ? LAYER_EFFECT
+               : (name == "overlay") ? LAYER_OVERLAY : -1;
+        int bm = (mode == "replace") ? BLEND_REPLACE : (mode == "add") ? BLEND_ADD
+               : (mode == "max") ? BLEND_MAX : (mode == "multiply") ? BLEND_MULTIPLY : -1;
+        if (c1 < 0 || id < 0 || bm < 0) {
+            Serial.println("❗ CMD:LAYER format: name,mode[,opacity]");
+            statusShow("❌ Layer format", 900);
+            return;
+        }
+
+        setLayering(true);
+        layers[id].mode = (BlendMode)bm;
+        if (c2 >= 0) layers[id].opacity = constrain(args.substring(c2 + 1).toInt(), 0, 255);
+        markAllDirty();
+        Serial.println("🧅 Layer " + name + " → " + mode + " @" + String(layers[id].opacity));
+        statusShow("Layer " + name + ": " + mode, 900);
+        return;
+    }
+
+    // CMD:NOTIFY=R,G,B[,ms] → strip flash on the overlay layer that fades out
+    if (cmd.startsWith("CMD:NOTIFY=")) {
+        String p = cmd.substring(11);
+        int c1 = p.indexOf(','), c2 = p.indexOf(',', c1 + 1), c3 = p.indexOf(',', c2 + 1);
+        int r = p.substring(0, c1).toInt();
+        int g = p.substring(c1 + 1, c2).toInt();
+        int b = (c3 >= 0) ? p.substring(c2 + 1, c3).toInt() : p.substring(c2 + 1).toInt();
+        uint16_t ms = (c3 >= 0) ? constrain(p.substring(c3 + 1).toInt(), 1, 60000) : 800;
+        overlayNotify(strip.Color(constrain(r, 0, 255), constrain(g, 0, 255), constrain(b, 0, 255)), ms);
+        return;
+    }
+
+    // CMD:MATRIX=w,h[,SERP|PROG] | OFF | SHOW → 2-D panel addressing
+    if (cmd.startsWith("CMD:MATRIX=")) {
+        String args = cmd.substring(11);
+        args.toUpperCase();
+        if (args == "SHOW") { matrixPrint(); return; }
+        if (args == "OFF") {
+            matrixOff();
+        } else {
+            int c1 = args.indexOf(',');
+            int c2 = (c1 >= 0) ? args.indexOf(',', c1 + 1) : -1;
+            int w = args.substring(0, c1 >= 0 ? c1 : args.length()).toInt();
+            int h = (c1 >= 0) ? args.substring(c1 + 1, c2 >= 0 ? c2 : args.length()).toInt() : 0;
+            bool serp = (c2 < 0) || args.substring(c2 + 1) != "PROG";
+            if (w <= 0 || h <= 0 || w > MATRIX_MAX_SIDE || h > MATRIX_MAX_SIDE || !matrixBegin(w, h, serp)) {
+                Serial.println("❗ Matrix must be 1-" + String(MATRIX_MAX_SIDE) + " per side and fit " + String(numLeds) + " LEDs: " + args);
+                statusShow("❌ Matrix", 900);
+                return;
+            }
+        }
+        matrixPrint();
+        statusShow(matrixMode ? "Matrix " + String(matrixW) + "x" + String(matrixH) : "Matrix OFF", 900);
+        return;
+    }
+
+    // CMD:SYMMETRY=OFF|MIRROR|KALEIDO[,n]|TILE,n → render one segment, copy it out
+    if (cmd.startsWith("CMD:SYMMETRY=")) {
+        String args = cmd.substring(13);
+        args.toUpperCase();
+        int c1 = args.indexOf(',');
+        String mode = (c1 >= 0) ? args.substring(0, c1) : args;
+        int n = (c1 >= 0) ? args.substring(c1 + 1).toInt() : 0;
+        if (mode == "OFF") symmetrySet(SYM_OFF, 1);
+        else if (mode == "MIRROR") symmetrySet(SYM_MIRROR, 2);
+        else if (mode == "KALEIDO") symmetrySet(SYM_KALEIDO, n ? n : 4);
+        else if (mode == "TILE" && n >= 2) symmetrySet(SYM_TILE, n);
+        else {
+            Serial.println("❗ Symmetry: OFF, MIRROR, KALEIDO[,n] or TILE,n: " + args);
+            statusShow("❌ Symmetry", 900);
+            return;
+        }
+        symmetryPrint();
+        statusShow("Symmetry " + mode, 900);
+        return;
+    }
+
+    // CMD:FIRE=cooling,sparking → FIRE_GLOW flame shape
+    if (cmd.startsWith("CMD:FIRE=")) {
+        String p = cmd.substring(9);
+        int c1 = p.indexOf(',');
+        fireCooling = constrain(p.substring(0, c1 >= 0 ? c1 : p.length()).toInt(), 0, 255);
+        if (c1 >= 0) fireSparking = constrain(p.substring(c1 + 1).toInt(), 0, 255);
+        Serial.print("🔥 Fire: cooling="); Serial.print(fireCooling);
+        Serial.print(" sparking="); Serial.println(fireSparking);
+        statusShow("Fire " + String(fireCooling) + "/" + String(fireSparking), 900);
+        return;
+    }
+
+    // CMD:COMETS=n → number of COLOR_COMET heads sharing the strip
+    if (cmd.startsWith("CMD:COMETS=")) {
+        cometCount = constrain(cmd.substring(11).toInt(), 1, 16);
+        particlesReset();
+        Serial.print("🌠 Comets: "); Serial.println(cometCount);
+        statusShow("Comets: " + String(cometCount), 900);
+        return;
+    }
+
+    // CMD:SEED=n → reseed the effect RNG (same seed + same commands = same frames)
+    if (cmd.startsWith("CMD:SEED=")) {
+        uint32_t seed = (uint32_t)cmd.substring(9).toInt();
+        rngSeed(seed);
+        Serial.print("🎲 Effect RNG seed: "); Serial.println(seed);
+        return;
+    }
+
+    // =====================
+    // 🗺 ZONES
+    // =====================
+    // CMD:ZONE=<n>,<start>,<end> | CMD:ZONE=<n>,OFF | CMD:ZONE=OFF | CMD:ZONE=LIST
+    if (cmd.startsWith("CMD:ZONE=")) {
+        String args = cmd.substring(9);
+        args.toUpperCase();
+        if (args == "LIST") { zonesPrint(); return; }
+        if (args == "OFF") {
+            zonesClear();
+            Serial.println("🗺 All zones removed");
+            statusShow("Zones OFF", 900);
+            return;
+        }
+
+        int c1 = args.indexOf(','), c2 = args.indexOf(',', c1 + 1);
+        int n = args.substring(0, c1).toInt();
+        if (c1 > 0 && args.substring(c1 + 1) == "OFF") {
+            zoneRemove(n);
+            Serial.print("🗺 Zone removed: "); Serial.println(n);
+            statusShow("Zone " + String(n) + " OFF", 900);
+            return;
+        }
+
+        int start = args.substring(c1 + 1, c2).toInt();
+        int end = args.substring(c2 + 1).toInt();
+        if (c1 < 0 || c2 < 0 || start < 0 || !zoneDefine(n, start, end)) {
+            Serial.println("❗ CMD:ZONE format: n,start,end (1-" + String(MAX_ZONES) + ", no overlap)");
+            statusShow("❌ Zone rejected", 900);
+            return;
+        }
+        Serial.print("🗺 Zone "); Serial.print(n); Serial.print(": ");
+        Serial.print(start); Serial.print("-"); Serial.println(end);
+        statusShow("Zone " + String(n) + ": " + String(start) + "-" + String(end), 1000);
+        return;
+    }
+
     // =====================
     // 📍 REGION CONTROL
     // =====================
     if (cmd.startsWith("CMD:REGION=")) {
         String region = cmd.substring(11);
         region.toLowerCase();
+        uint16_t oldStart = ledStart, oldEnd = ledEnd;
 
         if (region == "first_half") {
             ledStart = 0;
-            ledEnd = (NUM_LEDS / 2) - 1;
+            ledEnd = (numLeds / 2) - 1;
         }
         else if (region == "last_half") {
-            ledStart = NUM_LEDS / 2;
-            ledEnd = NUM_LEDS - 1;
+            ledStart = numLeds / 2;
+            ledEnd = numLeds - 1;
         }
         else if (region == "all" || region == "full") {
             ledStart = 0;
-            ledEnd = NUM_LEDS - 1;
+            ledEnd = numLeds - 1;
         }
         else if (region == "middle") {
-            ledStart = NUM_LEDS / 3;
-            ledEnd = (NUM_LEDS * 2 / 3) - 1;
+            ledStart = numLeds / 3;
+            ledEnd = (numLeds * 2 / 3) - 1;
         }
         else if (region == "left_quarter") {
             ledStart = 0;
-            ledEnd = NUM_LEDS / 4;
+            ledEnd = numLeds / 4;
         }
         else if (region == "right_quarter") {
-            ledStart = NUM_LEDS * 3 / 4;
-            ledEnd = NUM_LEDS - 1;
+            ledStart = numLeds * 3 / 4;
+            ledEnd = numLeds - 1;
         } 
         else {
             Serial.println("❗ Unknown region keyword");
@@ -423,22 +892,13 @@ void processCommand(String cmd) {
         }
 
         activeLEDCount = ledEnd - ledStart + 1;
-        strip.clear();
-        strip.show();
+        clearOutsideZones(oldStart, oldEnd);   // zones keep their pixels
+        clearOutsideZones(ledStart, ledEnd);
 
         Serial.print("✅ Region set: "); Serial.print(ledStart); Serial.print(" to "); Serial.println(ledEnd);
         statusShow("Region: " + region, 1000);
 
-        if (ledState && !scrollMode) {
-            if (multiColorCount > 0) {
-                if (basePattern == "stripe")        patternStripe();
-                else if (basePattern == "gradient") patternGradient();
-                else if (basePattern == "split")    patternSplit();
-                else                                renderMultiColorsBlock();
-            } else {
-                fillAll(currentColor);
-            }
-        }
+        if (ledState && !scrollMode) mainRedrawBase();
 
         return;
     }
@@ -5,6 +5,301 @@
 
 
 bool shimmerActive = false;
+uint8_t cometCount = 1;        // COLOR_COMET heads (CMD:COMETS=n)
+
+// =====================
+// 📋 EFFECT TABLE
+// =====================
+// CMD:EFFECT= name, default speed (ms per tick), whether it modulates the
+// static base (WAVE family), and keyframes: render every Nth tick and let the
+// output stage interpolate between the last two renders (1 = every tick).
+// Only effects that advance by keyStep per render can take N > 1; the rest
+// are step machines (flashes, strobes) that interpolation would smear.
+// loopPeriod: ticks after which a strictly periodic effect repeats exactly
+// (0 = not periodic); those play from the loop cache (loopcache.h).
+// parallel: the per-pixel pass is a pure function of (pixel, tick, state)
+// and may be split across cores on long ranges (parallel.h).
+#define WAVE_LOOP_TICKS   31    // ≈ 2π / 0.20 rad per tick
+#define HEART_LOOP_TICKS  130   // 10 + 15 + 10 + 15 + 80
+
+struct EffectInfo {
+  EffectType type;
+  const char* name;
+  uint16_t speed;
+  bool shimmer;
+  bool interpolable;
+  uint8_t keyframes;     // CMD:KEYFRAMES=name,n
+  uint16_t loopPeriod;
+  bool parallel;
+};
+
+EffectInfo effectTable[] = {
+  { WAVE,        "wave",        30,  true,  true,  2, WAVE_LOOP_TICKS,  true  },
+  { CENTER_WAVE, "center_wave", 30,  true,  true,  2, WAVE_LOOP_TICKS,  true  },
+  { BOUNCE_WAVE, "bounce_wave", 30,  true,  true,  2, 0,                true  },
+  { BLINK,       "blink",       300, false, false, 1, 0,                false },
+  { CHASE,       "chase",       60,  false, false, 1, 0,                false },
+  { PULSE,       "pulse",       20,  false, false, 1, 0,                false },
+  { RAINBOW,     "rainbow",     20,  false, true,  4, 256,              true  },
+  { STROBE,      "strobe",      40,  false, false, 1, 0,                false },
+  { TWINKLE,     "twinkle",     60,  false, false, 1, 0,                false },
+  { PARTY_FLASH, "party_flash", 30,  false, false, 1, 0,                false },
+  { FIRE_GLOW,   "fire_glow",   40,  false, false, 1, 0,                false },
+  { COLOR_COMET, "color_comet", 20,  false, false, 1, 0,                false },
+  { THUNDER,     "thunder",     30,  false, false, 1, 0,                false },
+  { FADE_LOOP,   "fade_loop",   20,  false, true,  4, 256,              false },
+  { SOFT_GLOW,   "soft_glow",   20,  false, false, 1, 0,                false },
+  { HEARTBEAT,   "heartbeat",   25,  false, false, 1, HEART_LOOP_TICKS, false },
+  { STAR_RAIN,   "star_rain",   40,  false, false, 1, 0,                false },
+  { FIREWORKS,   "fireworks",   30,  false, true,  2, 0,                false },
+  { DRIZZLE,     "drizzle",     40,  false, false, 1, 0,                false },
+  { FLASH,       "flash",       60,  false, false, 1, 0,                false },
+  { RAIN,        "rain",        50,  false, false, 1, 0,                false },
+};
+const uint8_t EFFECT_COUNT = sizeof(effectTable) / sizeof(effectTable[0]);
+
+EffectInfo* effectInfo(EffectType e) {
+  for (uint8_t i = 0; i < EFFECT_COUNT; i++) if (effectTable[i].type == e) return &effectTable[i];
+  return nullptr;
+}
+
+EffectInfo* effectByName(const String& name) {
+  for (uint8_t i = 0; i < EFFECT_COUNT; i++) if (name == effectTable[i].name) return &effectTable[i];
+  return nullptr;
+}
+
+// =====================
+// 🧠 EFFECT STATE
+// =====================
+// Per-effect counters that run across frames. The main strip owns one and
+// every zone (zones.h) owns its own; fx points at the one being rendered,
+// so two segments running the same effect don't share timing.
+#define PARTY_BOUNCE_COLORS 5
+#define MATRIX_BURSTS       4
+
+struct MatrixBurst {           // FIREWORKS on a panel (matrix.h)
+  uint8_t x = 0, y = 0;
+  uint8_t age = 0xFF;          // frames since launch, 0xFF = free
+  uint32_t color = 0;
+};
+
+struct EffectState {
+  float wavePhase = 0.0f;
+  float centerPhase = 0.0f;
+  struct { uint8_t flashCount = 0; bool flashing = false; bool lightOn = false; unsigned long pauseTimer = 0; } strobe;
+  struct { float pos = 0.0f; float v = 0.8f; } bounce;
+  struct {
+    uint8_t state = 0, frameCount = 0;
+    uint16_t offset = 0;
+    int bouncePos = 0;
+    bool bounceForward = true;
+    uint8_t bounceTrigger = 0;
+    uint32_t bounceColors[PARTY_BOUNCE_COLORS] = {};
+    bool flashOn = true;
+    uint8_t flashToggle = 0;
+  } party;
+  struct { uint8_t stage = 0, flickerCount = 0; unsigned long nextEvent = 0; } thunder;
+  struct { uint8_t level = 0; bool up = true; } glow;
+  struct { uint8_t stage = 0; uint16_t frameCounter = 0; } heart;
+  ParticleEmitter launcher = { 18, 0 };   // FIREWORKS: ≈ one burst every 14 frames
+  MatrixBurst bursts[MATRIX_BURSTS];
+  ParticleEmitter drops = { 0, 0 };       // RAIN on a panel
+  struct { bool state = true; uint8_t counter = 0; } flash;
+  struct { uint8_t stage = 0, flickerCount = 0; unsigned long nextEvent = 0; uint8_t strikeType = 0, bigThunderCounter = 0; } rain;
+  EffectType particleOwner = NONE;        // the particle pool belongs to one effect at a time
+  EffectType keyOwner = NONE;             // effect whose keyframe is in keyPrev
+  unsigned long keyLastStep = 0;          // last interpolated output step
+  LoopCache loop;                         // periodic effects' frames (loopcache.h)
+};
+
+EffectState mainEffectState;
+EffectState* fx = &mainEffectState;
+
+// =====================
+// 🎞 KEYFRAME INTERPOLATION
+// =====================
+uint8_t keyStep = 1;           // ticks the current render has to cover
+
+// Between keyframes: show lerp(previous keyframe, current keyframe) over the
+// range, dirtying it at most once per governor interpolation step (governor.h)
+void keyframeHold(unsigned long now, uint32_t interval) {
+  uint32_t t = now - lastMillis;
+  uint16_t k = (t >= interval) ? 256 : (uint16_t)(t * 256 / interval);
+  addKeySpan(ledStart, ledEnd, k);
+  if (now - fx->keyLastStep >= gov().keyStepMs) {
+    fx->keyLastStep = now;
+    markDirty(ledStart, ledEnd);
+  }
+}
+
+// =====================
+// 🔁 PERIODIC PLAYBACK
+// =====================
+const uint8_t HEART_STAGE_TICKS[5] = { 10, 15, 10, 15, 80 };
+
+// Put the effect's state at tick pos of its loop, so a tick missing from
+// the cache renders exactly what belongs there
+void loopSeek(uint16_t pos, uint16_t period) {
+  switch (currentEffect) {
+    case WAVE:        fx->wavePhase = 6.28318f * pos / period; break;
+    case CENTER_WAVE: fx->centerPhase = 6.28318f * pos / period; break;
+    case RAINBOW:     rainbowHue = pos * 256; break;
+    case FADE_LOOP:   fadeHue = pos * 256; break;
+    case HEARTBEAT: {
+      uint8_t st = 0;
+      while (st < 4 && pos >= HEART_STAGE_TICKS[st]) pos -= HEART_STAGE_TICKS[st++];
+      fx->heart.stage = st;
+      fx->heart.frameCounter = pos;
+      break;
+    }
+    default: break;
+  }
+}
+
+// Inverse of loopSeek: where the live state is now (arming without a jump)
+uint16_t loopTell(uint16_t period) {
+  switch (currentEffect) {
+    case WAVE:        return (uint16_t)(fx->wavePhase * period / 6.28318f + 0.5f) % period;
+    case CENTER_WAVE: return (uint16_t)(fx->centerPhase * period / 6.28318f + 0.5f) % period;
+    case RAINBOW:     return (rainbowHue >> 8) % period;
+    case FADE_LOOP:   return (fadeHue >> 8) % period;
+    case HEARTBEAT: {
+      uint16_t pos = fx->heart.frameCounter;
+      for (uint8_t st = 0; st < fx->heart.stage && st < 5; st++) pos += HEART_STAGE_TICKS[st];
+      return pos % period;
+    }
+    default: return 0;
+  }
+}
+
+// Everything the frames of the current loop depend on
+uint32_t loopKey(uint16_t len) {
+  uint32_t h = 2166136261UL;
+  h = loopHash(h, currentEffect);
+  h = loopHash(h, ((uint32_t)ledStart << 16) | len);
+  h = loopHash(h, effectSpeed);
+  h = loopHash(h, currentColor);
+  h = loopHash(h, compositeMode ? compositeColor1 ^ (compositeColor2 << 1) : 1);
+  h = loopHash(h, symmetryKey());
+  if (currentEffect == WAVE || currentEffect == CENTER_WAVE) {
+    h = loopHash(h, matrixActive() ? matrixKey() : 0);
+    h = loopHash(h, scrollBaseLen);
+    h = loopHash(h, scrollBase->hash);   // taken once per capture (indexed.h)
+  }
+  return h;
+}
+
+// Cache for this tick, armed/re-armed as needed; nullptr = render live
+LoopCache* loopCacheFor(const EffectInfo* info, uint16_t len) {
+  if (!loopCacheEnabled || !info || !info->loopPeriod) return nullptr;
+  if (currentEffect == WAVE || currentEffect == CENTER_WAVE) {
+    if (!scrollBaseCaptured || scrollBaseLen <= 0) captureScrollBase();
+  }
+  LoopCache& c = fx->loop;
+  uint32_t key = loopKey(len);
+  if (key != c.key) {
+    bool solid = currentEffect == FADE_LOOP || (currentEffect == HEARTBEAT && !compositeMode);
+    loopCacheArm(c, key, info->loopPeriod, len, solid, loopTell(info->loopPeriod));
+  }
+  return c.period ? &c : nullptr;
+}
+
+// =====================
+// 🔥 FIRE SIMULATION
+// =====================
+// FIRE_GLOW as a 1-D heat field: every tick each cell cools a little, heat
+// drifts up the strip (away from ledStart), and new sparks ignite near the
+// base. Heat maps to color through fireLUT (black → red → yellow → white),
+// or through the palette when one is set. All byte math, one generator
+// step per four pixels. Cells are indexed absolutely, so zones never share.
+//   CMD:FIRE=<cooling>,<sparking>   (defaults 55,120)
+#define FIRE_FLAME_LEN 60     // cells a default flame spans
+
+uint8_t fireCooling = 55;      // higher = shorter flames
+uint8_t fireSparking = 120;    // chance /255 of a new spark per tick
+uint8_t* fireHeat;             // numLeds, from the strip arena (stripconfig.h)
+uint8_t* fireNoise;            // numLeds, scratch
+uint32_t fireLUT[256];
+bool fireLUTReady = false;
+
+void fireBuildLUT() {
+  for (uint16_t h = 0; h < 256; h++) {
+    uint8_t t = (h * 191) >> 8;            // 0..190: three 64-step bands
+    uint8_t ramp = (t & 0x3F) << 2;
+    if (t & 0x80)      fireLUT[h] = strip.Color(255, 255, ramp);
+    else if (t & 0x40) fireLUT[h] = strip.Color(255, ramp, 0);
+    else               fireLUT[h] = strip.Color(ramp, 0, 0);
+  }
+  fireLUTReady = true;
+}
+
+void fireStep(uint8_t* heat, uint16_t len) {
+  uint8_t* noise = fireNoise;
+  rngFill(noise, len);
+
+  // Cool: up to cooling*10/len + 2 per cell; long strips cool like a
+  // FIRE_FLAME_LEN one so flames keep their height instead of filling it
+  uint16_t coolMax = (uint16_t)fireCooling * 10 / ((len < FIRE_FLAME_LEN) ? len : FIRE_FLAME_LEN) + 2;
+  for (uint16_t i = 0; i < len; i++) {
+    uint8_t c = (noise[i] * coolMax) >> 8;
+    heat[i] = (heat[i] > c) ? heat[i] - c : 0;
+  }
+
+  // Drift up: each cell takes (below + 2 × two below) / 3
+  for (uint16_t k = len - 1; k >= 2; k--) {
+    heat[k] = ((heat[k - 1] + 2 * heat[k - 2]) * 85) >> 8;
+  }
+
+  // Spark near the base
+  uint32_t r = rngNext();
+  if ((r & 0xFF) < fireSparking) {
+    uint16_t y = ((r >> 8) & 0xFF) * ((len < 7) ? len : 7) >> 8;
+    uint16_t h = heat[y] + 160 + (((r >> 16) & 0xFF) * 95 >> 8);
+    heat[y] = (h > 255) ? 255 : h;
+  }
+}
+
+// Scratch (not state): per-pixel brightness for the wave effects' scale kernel
+uint8_t* waveLevels;           // numLeds
+
+// =====================
+// ⚡ RANGE-PARALLEL PASSES
+// =====================
+bool fxParallel = false;       // the effect being rendered is marked parallel
+
+// Symmetry of the pass being rendered: ledEnd is narrowed to the unique
+// segment while fxSymPixels, fxFullEnd is the real end (symmetry.h)
+bool fxSymPixels = false;
+uint16_t fxFullEnd = 0;
+
+// Mid-effect push (the lightning flashes of THUNDER and RAIN): copy the
+// segment out first so every copy flashes, then narrow back to it
+void effectCommit() {
+  if (!fxSymPixels) {
+    commitFrame();
+    return;
+  }
+  uint16_t segEnd = ledEnd;
+  symmetryExpand(fxFullEnd);
+  commitFrame();
+  ledEnd = segEnd;
+}
+
+// body(from, to) over [0, len): split across cores for parallel effects
+// (parallel.h), one inline call for everything else
+template <typename F>
+inline void renderSlices(uint16_t len, F&& body) {
+  if (fxParallel) parallelFor(len, body);
+  else body(0, len);
+}
+
+// Wave family: the base picture scaled by waveLevels over the range
+void waveScale() {
+  uint32_t* out = drawRange(ledStart, scrollBaseLen);
+  renderSlices(scrollBaseLen, [&](uint16_t from, uint16_t to) {
+    indexedScaleSlice(out, *scrollBase, waveLevels, from, to);
+  });
+}
 
 void resetEffectState() {
   waveIndex = 0;
@@ -22,6 +317,68 @@ void resetEffectState() {
   thunderState = true;
   fadeHue = 0;
   rainbowHue = 0;
+  setEffectLevel(255);
+  particlesReset();
+  for (uint8_t b = 0; b < MATRIX_BURSTS; b++) fx->bursts[b].age = 0xFF;
+  fx->keyOwner = NONE;
+  memset(&fireHeat[ledStart], 0, ledEnd - ledStart + 1);
+}
+
+// FIREWORKS burst colors
+uint32_t fireworkColor(uint8_t k) {
+  switch (k) {
+    case 0:  return strip.Color(255, 0, 0);
+    case 1:  return strip.Color(0, 255, 0);
+    case 2:  return strip.Color(0, 0, 255);
+    case 3:  return strip.Color(255, 100, 0);
+    case 4:  return strip.Color(0, 255, 100);
+    default: return strip.Color(100, 0, 255);
+  }
+}
+
+// =====================
+// 🔲 MATRIX SHAPES
+// =====================
+// 2-D variants (matrix.h). Grid cells sit at ledStart + XY(x, y).
+#define MATRIX_BURST_LIFE 24     // frames a firework ring takes to fade
+
+// RAIN: a drop enters the top of a random column and falls with a short
+// tail, dying as it leaves the bottom row
+void matrixRainDrop(uint32_t color, uint8_t flags) {
+  int16_t v = rngRange(0x90, 0x140);                  // rows per frame, 8.8
+  uint8_t life = ((uint16_t)matrixH * 256 + v - 1) / v;
+  particleSpawn(rngBelow(matrixW) * matrixH, color, 0, v, 0, 3, life, flags | PF_COLUMN);
+}
+
+// FIREWORKS: each burst is a ring growing from its center and fading
+void matrixBurstsRender() {
+  for (uint8_t b = 0; b < MATRIX_BURSTS; b++) {
+    MatrixBurst& m = fx->bursts[b];
+    if (m.age == 0xFF) continue;
+    float r = m.age * 0.45f;                               // cells
+    uint16_t level = 255 * (MATRIX_BURST_LIFE - m.age) / MATRIX_BURST_LIFE;
+    for (uint8_t y = 0; y < matrixH; y++) {
+      for (uint8_t x = 0; x < matrixW; x++) {
+        float dx = (float)x - m.x, dy = (float)y - m.y;
+        float w = 1.0f - fabsf(sqrtf(dx * dx + dy * dy) - r) * 0.8f;   // ring ≈ 2.5 cells wide
+        if (w > 0.0f) addPixel(ledStart + XY(x, y), scaleColor(m.color, (uint8_t)(level * w)));
+      }
+    }
+    m.age = (m.age + keyStep >= MATRIX_BURST_LIFE) ? 0xFF : m.age + keyStep;
+  }
+}
+
+void matrixBurstLaunch(uint32_t color) {
+  uint8_t slot = 0;
+  for (uint8_t b = 0; b < MATRIX_BURSTS; b++) {
+    if (fx->bursts[b].age == 0xFF) { slot = b; break; }
+    if (fx->bursts[b].age > fx->bursts[slot].age) slot = b;   // else replace the oldest
+  }
+  MatrixBurst& m = fx->bursts[slot];
+  m.x = (matrixW > 4) ? rngRange(2, matrixW - 2) : rngBelow(matrixW);
+  m.y = (matrixH > 4) ? rngRange(2, matrixH - 2) : rngBelow(matrixH);
+  m.age = 0;
+  m.color = color;
 }
 
 // =====================
@@ -30,10 +387,55 @@ void resetEffectState() {
 void runCurrentEffect() {
   if (currentEffect == NONE) return;
   unsigned long now = millis();
-  if (now - lastMillis < effectSpeed) return;
+  EffectInfo* info = effectInfo(currentEffect);
+  uint8_t keys = (info && info->interpolable && info->keyframes > 1) ? info->keyframes : 1;
+  uint32_t interval = (uint32_t)effectSpeed * keys;
+  if (now - lastMillis < interval) {
+    if (keys > 1 && fx->keyOwner == currentEffect) keyframeHold(now, interval);
+    return;
+  }
   lastMillis = now;
+  keyStep = keys;
 
   uint16_t len = ledEnd - ledStart + 1;
+  if (keys > 1) {
+    // The keyframe on the LEDs becomes the one we interpolate from
+    memcpy(&keyPrev[ledStart], &frame[ledStart], len * sizeof(uint32_t));
+    fx->keyOwner = currentEffect;
+    keyframeHold(now, interval);
+  }
+  beginLayer(LAYER_EFFECT);   // no-op unless the compositor is on
+
+  // Symmetry: render the unique segment only, copied out after (symmetry.h)
+  fxFullEnd = ledEnd;
+  fxSymPixels = symmetryOn() && !(info && info->shimmer);
+  if (fxSymPixels) {
+    len = symmetryLen(len);
+    ledEnd = ledStart + len - 1;
+  }
+
+  // Periodic effects: a tick already in the loop cache is just copied out
+  LoopCache* loop = loopCacheFor(info, len);
+  uint16_t loopPos = 0;
+  if (loop) {
+    loopPos = loop->pos;
+    loop->pos = (loopPos + keyStep) % loop->period;
+    if (loopCacheHas(*loop, loopPos)) {
+      loopCachePlay(*loop, loopPos, ledStart);
+      if (fxSymPixels) symmetryExpand(fxFullEnd);
+      endLayer();
+      return;
+    }
+    loopSeek(loopPos, loop->period);
+  }
+  fxParallel = info && info->parallel;
+
+  // The particle pool belongs to one effect at a time (per context)
+  EffectType& particleOwner = fx->particleOwner;
+  if (particleOwner != currentEffect) {
+    particlesReset();
+    particleOwner = currentEffect;
+  }
 
   switch (currentEffect) {
 
@@ -46,27 +448,35 @@ case WAVE: {
   // Ensure base captured from current pattern/colors
   if (!scrollBaseCaptured || scrollBaseLen <= 0) captureScrollBase();
 
-  static float phase = 0.0f;        // time offset
+  float& phase = fx->wavePhase;     // time offset
   const float spatialK = 0.15f;     // waves per LED (lower = wider)
   const float base     = 0.35f;     // min brightness scale (0..1)
   const float range    = 0.65f;     // amplitude (base+range ≤ 1)
 
-  for (int i = 0; i < scrollBaseLen; i++) {
-    uint32_t c = scrollBase[i];
-    uint8_t r0 = (c >> 16) & 0xFF;
-    uint8_t g0 = (c >> 8)  & 0xFF;
-    uint8_t b0 =  c        & 0xFF;
-
-    float s = base + range * (0.5f * (sinf(i * spatialK + phase) + 1.0f));
-    uint8_t r = (uint8_t)constrain((int)(r0 * s), 0, 255);
-    uint8_t g = (uint8_t)constrain((int)(g0 * s), 0, 255);
-    uint8_t b = (uint8_t)constrain((int)(b0 * s), 0, 255);
-    strip.setPixelColor(ledStart + i, strip.Color(r, g, b));
+  if (matrixActive()) {
+    // Diagonal bands across the panel; cells past the grid stay at the floor
+    const float k2 = 0.45f;
+    memset(waveLevels, (uint8_t)(base * 255.0f), scrollBaseLen);
+    for (uint8_t y = 0; y < matrixH; y++) {
+      for (uint8_t x = 0; x < matrixW; x++) {
+        float s = base + range * (0.5f * (sinf((x + y) * k2 + phase) + 1.0f));
+        waveLevels[XY(x, y)] = (uint8_t)(s * 255.0f);
+      }
+    }
+  } else {
+    int n = symmetryLen(scrollBaseLen);   // mirrored levels keep the picture
+    renderSlices(n, [&](uint16_t from, uint16_t to) {
+      for (uint16_t i = from; i < to; i++) {
+        float s = base + range * (0.5f * (sinf(i * spatialK + phase) + 1.0f));
+        waveLevels[i] = (uint8_t)(s * 255.0f);
+      }
+    });
+    symExpand(waveLevels, scrollBaseLen);
   }
-  strip.show();
+  waveScale();
 
-  phase += 0.20f;                   // travel speed
-  if (phase > 6.28318f) phase -= 6.28318f;
+  phase += 0.20f * keyStep;         // travel speed
+  while (phase > 6.28318f) phase -= 6.28318f;
   break;
 }
 
@@ -74,35 +484,32 @@ case WAVE: {
     // 💡 Blink effect
     case BLINK:
       if (blinkOn) fillAll(currentColor);
-      else { strip.clear(); strip.show(); }
+      else { clearRange(ledStart, ledEnd); }
       blinkOn = !blinkOn;
       break;
 
     // 🏃‍♂️ Chase effect
     case CHASE:
-      strip.clear();
-      strip.setPixelColor(ledStart + (chaseIndex % len), currentColor);
-      strip.setPixelColor(ledStart + ((chaseIndex + 2) % len), currentColor);
-      strip.setPixelColor(ledStart + ((chaseIndex + 4) % len), currentColor);
-      strip.show();
+      clearRange(ledStart, ledEnd);
+      setPixel(ledStart + (chaseIndex % len), currentColor);
+      setPixel(ledStart + ((chaseIndex + 2) % len), currentColor);
+      setPixel(ledStart + ((chaseIndex + 4) % len), currentColor);
       if (++chaseIndex >= len) { chaseIndex = 0; chaseRep++; }
       if (chaseRep >= 10) currentEffect = NONE;
       break;
 
     // ⚡ Strobe effect
     case STROBE: {
-      static uint8_t flashCount = 0;
-      static bool flashing = false;
-      static bool lightOn = false;
-      static unsigned long pauseTimer = 0;
+      uint8_t& flashCount = fx->strobe.flashCount;
+      bool& flashing = fx->strobe.flashing;
+      bool& lightOn = fx->strobe.lightOn;
+      unsigned long& pauseTimer = fx->strobe.pauseTimer;
 
       const uint8_t BURST_FLASHES = 4;
-      const uint8_t FLASH_SPEED = 40;
       const uint16_t PAUSE_AFTER_BURST = 500;
 
       if (!flashing && millis() < pauseTimer) {
-        strip.clear();
-        strip.show();
+        clearRange(ledStart, ledEnd);
         break;
       }
       if (!flashing) {
@@ -110,14 +517,12 @@ case WAVE: {
         flashCount = 0;
       }
       if (lightOn) {
-        strip.clear();
-        strip.show();
+        clearRange(ledStart, ledEnd);
       } else {
         uint32_t flashColor = (currentColor == 0) ? strip.Color(255, 255, 255) : currentColor;
         for (uint16_t i = ledStart; i <= ledEnd; i++) {
-          strip.setPixelColor(i, flashColor);
+          setPixel(i, flashColor);
         }
-        strip.show();
       }
       lightOn = !lightOn;
       if (!lightOn) flashCount++;
@@ -130,7 +535,7 @@ case WAVE: {
 
     // 🌌 Pulse effect
     case PULSE:
-      strip.setBrightness(pulseBrightness);
+      setEffectLevel(pulseBrightness);
       fillAll(currentColor);
       pulseBrightness += (pulseUp ? 5 : -5);
       if (pulseBrightness >= 255) pulseUp = false;
@@ -142,30 +547,38 @@ case CENTER_WAVE: {
   shimmerActive = true;
   if (!scrollBaseCaptured || scrollBaseLen <= 0) captureScrollBase();
 
-  static float phase = 0.0f;
+  float& phase = fx->centerPhase;
   const float k      = 0.22f;  // spatial frequency
   const float base   = 0.35f;
   const float range  = 0.65f;
 
   float mid = (scrollBaseLen - 1) * 0.5f;
 
-  for (int i = 0; i < scrollBaseLen; i++) {
-    int idx = ledStart + i;
-    uint32_t c = scrollBase[i];
-    uint8_t r0 = (c >> 16) & 0xFF, g0 = (c >> 8) & 0xFF, b0 = c & 0xFF;
-
-    float d = fabsf(i - mid);
-    // use cos(|x|*k - phase) so the bright band moves outward symmetrically
-    float s = base + range * (0.5f * (cosf(d * k - phase) + 1.0f));
-
-    uint8_t r = (uint8_t)constrain((int)(r0 * s), 0, 255);
-    uint8_t g = (uint8_t)constrain((int)(g0 * s), 0, 255);
-    uint8_t b = (uint8_t)constrain((int)(b0 * s), 0, 255);
-    strip.setPixelColor(idx, strip.Color(r, g, b));
+  if (matrixActive()) {
+    // Rings expanding from the panel center
+    const float k2 = 0.9f;
+    memset(waveLevels, (uint8_t)(base * 255.0f), scrollBaseLen);
+    for (uint8_t y = 0; y < matrixH; y++) {
+      for (uint8_t x = 0; x < matrixW; x++) {
+        float s = base + range * (0.5f * (cosf(matrixRadius(x, y) * k2 - phase) + 1.0f));
+        waveLevels[XY(x, y)] = (uint8_t)(s * 255.0f);
+      }
+    }
+  } else {
+    int n = symmetryLen(scrollBaseLen);
+    renderSlices(n, [&](uint16_t from, uint16_t to) {
+      for (uint16_t i = from; i < to; i++) {
+        float d = fabsf(i - mid);
+        // use cos(|x|*k - phase) so the bright band moves outward symmetrically
+        float s = base + range * (0.5f * (cosf(d * k - phase) + 1.0f));
+        waveLevels[i] = (uint8_t)(s * 255.0f);
+      }
+    });
+    symExpand(waveLevels, scrollBaseLen);
   }
-  strip.show();
-  phase += 0.20f;
-  if (phase > 6.28318f) phase -= 6.28318f;
+  waveScale();
+  phase += 0.20f * keyStep;
+  while (phase > 6.28318f) phase -= 6.28318f;
   break;
 }
 
@@ -174,54 +587,50 @@ case BOUNCE_WAVE: {
   shimmerActive = true;
   if (!scrollBaseCaptured || scrollBaseLen <= 0) captureScrollBase();
 
-  static float pos = 0.0f;
-  static float v   = 0.8f;   // pixels per frame
+  float& pos = fx->bounce.pos;
+  float& v   = fx->bounce.v;   // pixels per frame
   const float k    = 0.28f;  // spatial frequency for the lobe shape
   const float base = 0.35f;
   const float range= 0.65f;
 
-  // Bounce position
-  pos += v;
-  if (pos >= scrollBaseLen - 1) { pos = scrollBaseLen - 1; v = -v; }
-  if (pos <= 0)                  { pos = 0;                v = -v; }
-
-  for (int i = 0; i < scrollBaseLen; i++) {
-    uint32_t c = scrollBase[i];
-    uint8_t r0 = (c >> 16) & 0xFF, g0 = (c >> 8) & 0xFF, b0 = c & 0xFF;
-
-    float x = (i - pos) * k;
-    // bright lobe around 'pos' using cos falloff
-    float s = base + range * (0.5f * (cosf(x) + 1.0f));
-
-    uint8_t r = (uint8_t)constrain((int)(r0 * s), 0, 255);
-    uint8_t g = (uint8_t)constrain((int)(g0 * s), 0, 255);
-    uint8_t b = (uint8_t)constrain((int)(b0 * s), 0, 255);
-    strip.setPixelColor(ledStart + i, strip.Color(r, g, b));
-  }
-  strip.show();
+  // Bounce position (across the unique segment when mirrored)
+  int n = symmetryLen(scrollBaseLen);
+  pos += v * keyStep;
+  if (pos >= n - 1) { pos = n - 1; v = -v; }
+  if (pos <= 0)     { pos = 0;     v = -v; }
+
+  renderSlices(n, [&](uint16_t from, uint16_t to) {
+    for (uint16_t i = from; i < to; i++) {
+      float x = (i - pos) * k;
+      // bright lobe around 'pos' using cos falloff
+      float s = base + range * (0.5f * (cosf(x) + 1.0f));
+      waveLevels[i] = (uint8_t)(s * 255.0f);
+    }
+  });
+  symExpand(waveLevels, scrollBaseLen);
+  waveScale();
   break;
 }
 
 
     // ✨ Twinkle effect
     case TWINKLE:
-      strip.setPixelColor(ledStart + random(len), currentColor);
-      strip.setPixelColor(ledStart + random(len), 0);
-      strip.show();
+      setPixel(ledStart + rngBelow(len), currentColor);
+      setPixel(ledStart + rngBelow(len), 0);
       break;
 
     // 🎉 Party Flash effect
     case PARTY_FLASH: {
-      static uint8_t state = 0;
-      static uint8_t frameCount = 0;
-      static uint16_t offset = 0;
-      static uint8_t framesPerState = 18;
+      uint8_t& state = fx->party.state;
+      uint8_t& frameCount = fx->party.frameCount;
+      uint16_t& offset = fx->party.offset;
+      const uint8_t framesPerState = 18;
 
-      static int bouncePos = 0;
-      static bool bounceForward = true;
-      static uint8_t bounceTrigger = 0;
-      static const uint8_t bounceColorCount = 5;
-      static uint32_t bounceColors[bounceColorCount];
+      int& bouncePos = fx->party.bouncePos;
+      bool& bounceForward = fx->party.bounceForward;
+      uint8_t& bounceTrigger = fx->party.bounceTrigger;
+      const uint8_t bounceColorCount = PARTY_BOUNCE_COLORS;
+      uint32_t* bounceColors = fx->party.bounceColors;
 
       const uint8_t maxState = 5;
       const uint8_t blockSize = 10;
@@ -236,32 +645,32 @@ case BOUNCE_WAVE: {
         strip.Color(0, 255, 255)
       };
 
-      strip.clear();
+      clearRange(ledStart, ledEnd);
 
       switch (state) {
         case 0:  // Rotating Color Bands
           for (int i = 0; i < len; i++) {
             int colorIndex = ((i + offset) / blockSize) % numColors;
-            strip.setPixelColor(ledStart + i, colors[colorIndex]);
+            setPixel(ledStart + i, colors[colorIndex]);
           }
           break;
 
         case 1:  // Random Sparkles
           for (int i = 0; i < 10; i++) {
-            int idx = ledStart + random(len);
-            strip.setPixelColor(idx, strip.Color(random(255), random(255), random(255)));
+            int idx = ledStart + rngBelow(len);
+            setPixel(idx, strip.Color(rngBelow(255), rngBelow(255), rngBelow(255)));
           }
           break;
 
         case 2: {  // Strong White Flash
-          static bool flashOn = true;
-          static uint8_t flashToggle = 0;
+          bool& flashOn = fx->party.flashOn;
+          uint8_t& flashToggle = fx->party.flashToggle;
 
           if (flashOn) {
             for (uint16_t i = 0; i < len; i++)
-              strip.setPixelColor(ledStart + i, strip.Color(255, 255, 255));
+              setPixel(ledStart + i, strip.Color(255, 255, 255));
           } else {
-            strip.clear();
+            clearRange(ledStart, ledEnd);
           }
 
           flashOn = !flashOn;
@@ -276,23 +685,24 @@ case BOUNCE_WAVE: {
         case 3:  // Spark Wave
           for (int i = 0; i < len; i++) {
             uint8_t wave = (sin((i + offset) * 0.3) + 1) * 127;
-            strip.setPixelColor(ledStart + i, strip.Color(wave, random(100), random(255)));
+            uint32_t rnd = rngNext();   // one draw covers both random channels
+            setPixel(ledStart + i, strip.Color(wave, rngByteRange(rnd, 0, 100), rngByteRange(rnd >> 8, 0, 255)));
           }
           break;
 
         case 4: {  // Bounce LEDs
           if (bounceTrigger == 0) {
-            bouncePos = random(len - bounceColorCount);
-            bounceForward = random(2);
+            bouncePos = rngBelow(len - bounceColorCount);
+            bounceForward = rngBelow(2);
             for (int i = 0; i < bounceColorCount; i++) {
-              bounceColors[i] = strip.Color(random(255), random(255), random(255));
+              bounceColors[i] = strip.Color(rngBelow(255), rngBelow(255), rngBelow(255));
             }
           }
 
           for (int i = 0; i < bounceColorCount; i++) {
             int pos = bouncePos + i;
             if (pos >= 0 && pos < len)
-              strip.setPixelColor(ledStart + pos, bounceColors[i]);
+              setPixel(ledStart + pos, bounceColors[i]);
           }
 
           if (bounceForward) bouncePos += 2;
@@ -310,7 +720,6 @@ case BOUNCE_WAVE: {
         }
       }
 
-      strip.show();
       frameCount++;
       offset++;
       if (state != 2 && state != 4 && frameCount >= framesPerState) {
@@ -321,63 +730,61 @@ case BOUNCE_WAVE: {
     }
 
     // 🔥 Fire Glow effect
-    case FIRE_GLOW:
-      for (uint16_t i = 0; i < len; i++) {
-        int flicker = random(160, 255);
-        strip.setPixelColor(ledStart + i, strip.Color(flicker, flicker / 6, 0));
-      }
-      strip.show();
+    case FIRE_GLOW: {
+      uint8_t* heat = &fireHeat[ledStart];
+      if (len >= 3) fireStep(heat, len);
+      if (!fireLUTReady) fireBuildLUT();
+      const uint32_t* lut = paletteActive() ? activePalette->lut : fireLUT;
+      uint32_t* out = drawRange(ledStart, len);
+      for (uint16_t i = 0; i < len; i++) out[i] = lut[heat[i]];
       break;
+    }
 
     // 🌠 Color Comet effect
     case COLOR_COMET: {
       const uint8_t tailLength = 10;
-      strip.clear();
-
-      for (int i = 0; i < tailLength; i++) {
-        int index = waveIndex - i;
-        if (index < 0) continue;
-        float fade = 1.0 - (float)i / tailLength;
-        uint8_t r = (uint8_t)((currentColor >> 16 & 0xFF) * fade);
-        uint8_t g = (uint8_t)((currentColor >> 8 & 0xFF) * fade);
-        uint8_t b = (uint8_t)((currentColor & 0xFF) * fade);
-        strip.setPixelColor(ledStart + index, strip.Color(r, g, b));
+      clearRange(ledStart, ledEnd);
+
+      // Evenly spaced heads, one pixel per frame, wrapping around the range.
+      // With a palette set, the comet takes the palette color of where it is.
+      uint8_t cometFlags = PF_WRAP | (paletteActive() ? PF_PALETTE : 0);
+      for (uint16_t live = particlesLive(); live < cometCount; live++) {
+        int pos = (uint32_t)live * len / cometCount;
+        particleSpawn(pos, currentColor, 0, 256, 0, tailLength, 0, cometFlags);
       }
-
-      strip.show();
-      waveIndex++;
-      if (waveIndex >= len) waveIndex = 0;
+      particlesRender(ledStart, len);
+      particlesUpdate(len, keyStep);
       break;
     }
 
     // ⚡ Thunder effect
     case THUNDER: {
-      static uint8_t stage = 0;
-      static uint8_t flickerCount = 0;
-      static unsigned long nextEvent = 0;
+      uint8_t& stage = fx->thunder.stage;
+      uint8_t& flickerCount = fx->thunder.flickerCount;
+      unsigned long& nextEvent = fx->thunder.nextEvent;
 
       if (millis() < nextEvent) break;
 
       switch (stage) {
         case 0:
-          flickerCount = random(2, 5);
+          flickerCount = rngRange(2, 5);
           stage = 1;
           break;
 
         case 1:
           if (flickerCount > 0) {
-            uint8_t brightness = random(50, 180); 
+            uint8_t brightness = rngRange(50, 180); 
             for (uint16_t i = ledStart; i <= ledEnd; i++) {
-              strip.setPixelColor(i, strip.Color(brightness, brightness, brightness));
+              setPixel(i, strip.Color(brightness, brightness, brightness));
             }
-            strip.show();
+            effectCommit();
 
-            delay(30);
-            strip.clear();
-            strip.show();
+            effectDelay(30);
+            clearRange(ledStart, ledEnd);
+            effectCommit();
 
             flickerCount--;
-            nextEvent = millis() + random(50, 120);
+            nextEvent = millis() + rngRange(50, 120);
           } else {
             stage = 2;
           }
@@ -385,59 +792,62 @@ case BOUNCE_WAVE: {
 
         case 2:
           for (uint16_t i = ledStart; i <= ledEnd; i++) {
-            strip.setPixelColor(i, strip.Color(255, 255, 255));
+            setPixel(i, strip.Color(255, 255, 255));
           }
-          strip.show();
-          delay(60);
-          strip.clear();
-          strip.show();
+          effectCommit();
+          effectDelay(60);
+          clearRange(ledStart, ledEnd);
+          effectCommit();
 
           stage = 3;
-          nextEvent = millis() + random(100, 500);
+          nextEvent = millis() + rngRange(100, 500);
           break;
 
         case 3:
-          if (random(0, 2)) { 
-            uint8_t afterGlow = random(50, 120);
+          if (rngRange(0, 2)) { 
+            uint8_t afterGlow = rngRange(50, 120);
             for (uint16_t i = ledStart; i <= ledEnd; i++) {
-              strip.setPixelColor(i, strip.Color(afterGlow, afterGlow, afterGlow));
+              setPixel(i, strip.Color(afterGlow, afterGlow, afterGlow));
             }
-            strip.show();
-            delay(40);
-            strip.clear();
-            strip.show();
+            effectCommit();
+            effectDelay(40);
+            clearRange(ledStart, ledEnd);
+            effectCommit();
           }
           stage = 0;
-          nextEvent = millis() + random(2000, 6000);
+          nextEvent = millis() + rngRange(2000, 6000);
           break;
       }
       break;
     }
 
     // 🌈 Fade loop
-    case FADE_LOOP:
-      for (uint16_t i = 0; i < len; i++)
-        strip.setPixelColor(ledStart + i, strip.gamma32(strip.ColorHSV(fadeHue)));
-      strip.show();
-      fadeHue = (fadeHue + 256) % 65536;
+    case FADE_LOOP: {
+      uint32_t c = strip.gamma32(strip.ColorHSV(fadeHue));   // one color for the whole range
+      for (uint16_t i = 0; i < len; i++) setPixel(ledStart + i, c);
+      fadeHue = (fadeHue + 256UL * keyStep) % 65536;
       break;
+    }
 
     // 🌈 Rainbow
-    case RAINBOW:
-      for (uint16_t i = 0; i < len; i++) {
-        uint16_t hue = rainbowHue + (i * 65536L / len);
-        strip.setPixelColor(ledStart + i, strip.gamma32(strip.ColorHSV(hue)));
-      }
-      strip.show();
-      rainbowHue = (rainbowHue + 256) % 65536;
+    case RAINBOW: {
+      uint32_t* out = drawRange(ledStart, len);
+      renderSlices(len, [&](uint16_t from, uint16_t to) {
+        for (uint16_t i = from; i < to; i++) {
+          uint16_t hue = rainbowHue + (i * 65536L / len);
+          out[i] = strip.gamma32(strip.ColorHSV(hue));
+        }
+      });
+      rainbowHue = (rainbowHue + 256UL * keyStep) % 65536;
       break;
+    }
 
     // 🌟 Soft glow
     case SOFT_GLOW: {
-      static uint8_t glowLevel = 0;
-      static bool glowUp = true;
+      uint8_t& glowLevel = fx->glow.level;
+      bool& glowUp = fx->glow.up;
 
-      strip.setBrightness(glowLevel);
+      setEffectLevel(glowLevel);
       fillAll(currentColor);
 
       if (glowUp) glowLevel += 2;
@@ -451,16 +861,16 @@ case BOUNCE_WAVE: {
 
     // ❤️ Heartbeat
     case HEARTBEAT: {
-      static uint8_t stage = 0;
-      static uint16_t frameCounter = 0;
+      uint8_t& stage = fx->heart.stage;
+      uint16_t& frameCounter = fx->heart.frameCounter;
       uint8_t r = 255, g = 5, b = 5;
       uint32_t hbColor = strip.Color(r, g, b);
 
       switch (stage) {
         case 0: fillAll(hbColor); break;
-        case 1: strip.clear(); break;
+        case 1: clearRange(ledStart, ledEnd); break;
         case 2: fillAll(hbColor); break;
-        case 3: strip.clear(); break;
+        case 3: clearRange(ledStart, ledEnd); break;
         case 4: {
           float fade = 1.0 - (frameCounter / 80.0);
           uint8_t fr = r * fade;
@@ -469,10 +879,9 @@ case BOUNCE_WAVE: {
           fillAll(strip.Color(fr, fg, fb));
           break;
         }
-        default: strip.clear(); break;
+        default: clearRange(ledStart, ledEnd); break;
       }
 
-      strip.show();
       frameCounter++;
 
       if ((stage == 0 || stage == 2) && frameCounter >= 10) { stage++; frameCounter = 0; }
@@ -483,131 +892,78 @@ case BOUNCE_WAVE: {
 
     // 🌠 Star Rain
     case STAR_RAIN: {
-      static uint8_t sparkleCount = 10;
-      static uint8_t fadeAmount = 20;
-
-      for (int i = ledStart; i <= ledEnd; i++) {
-        uint32_t color = strip.getPixelColor(i);
-        uint8_t r = (color >> 16) & 0xFF;
-        uint8_t g = (color >> 8) & 0xFF;
-        uint8_t b = color & 0xFF;
-        r = (r >= fadeAmount) ? r - fadeAmount : 0;
-        g = (g >= fadeAmount) ? g - fadeAmount : 0;
-        b = (b >= fadeAmount) ? b - fadeAmount : 0;
-        strip.setPixelColor(i, r, g, b);
-      }
+      const uint8_t sparkleCount = govScale(10);
+      const uint8_t fadeAmount = 20;
+
+      clearRange(ledStart, ledEnd);
 
       for (int i = 0; i < sparkleCount; i++) {
-        int idx = ledStart + random(ledEnd - ledStart + 1);
-        strip.setPixelColor(idx, strip.Color(random(200, 255), random(200, 255), random(200, 255)));
+        uint32_t rnd = rngNext();
+        particleSpawn(rngBelow(len),
+                      strip.Color(rngByteRange(rnd, 200, 255),
+                                  rngByteRange(rnd >> 8, 200, 255),
+                                  rngByteRange(rnd >> 16, 200, 255)),
+                      fadeAmount);
       }
-      strip.show();
+      particlesRender(ledStart, len);
+      particlesUpdate(len, keyStep);
       break;
     }
 
     // 🎆 Fireworks
     case FIREWORKS: {
-      static const uint8_t maxFireworks = 8;
-      static struct {
-        int pos;
-        uint32_t baseColor;
-        uint8_t age;
-        bool active;
-        uint16_t nextLaunchIn;
-      } fireworks[maxFireworks];
-
-      for (int i = ledStart; i <= ledEnd; i++) {
-        uint32_t col = strip.getPixelColor(i);
-        uint8_t r = (col >> 16) & 0xFF;
-        uint8_t g = (col >> 8) & 0xFF;
-        uint8_t b = col & 0xFF;
-        r = (r > 10) ? r - 10 : 0;
-        g = (g > 10) ? g - 10 : 0;
-        b = (b > 10) ? b - 10 : 0;
-        strip.setPixelColor(i, r, g, b);
-      }
+      ParticleEmitter& launcher = fx->launcher;
 
-      for (int i = 0; i < maxFireworks; i++) {
-        if (!fireworks[i].active) {
-          if (fireworks[i].nextLaunchIn == 0) {
-            fireworks[i].pos = random(ledStart + 10, ledEnd - 10);
-
-            uint8_t r = 0, g = 0, b = 0;
-            switch (random(6)) {
-              case 0: r = 255; break;
-              case 1: g = 255; break;
-              case 2: b = 255; break;
-              case 3: r = 255; g = 100; break;
-              case 4: g = 255; b = 100; break;
-              case 5: r = 100; b = 255; break;
-            }
+      clearRange(ledStart, ledEnd);
 
-            fireworks[i].baseColor = strip.Color(r, g, b);
-            fireworks[i].age = 0;
-            fireworks[i].active = true;
-          } else {
-            fireworks[i].nextLaunchIn--;
-          }
+      if (matrixActive()) {
+        uint8_t bursts = 0;
+        for (uint8_t t = 0; t < keyStep; t++) bursts += emitterTick(launcher);
+        for (uint8_t n = bursts; n > 0; n--) {
+          matrixBurstLaunch(fireworkColor(rngBelow(6)));
         }
+        matrixBurstsRender();
+        break;
       }
 
-      for (int i = 0; i < maxFireworks; i++) {
-        if (fireworks[i].active) {
-          int center = fireworks[i].pos;
-          uint32_t base = fireworks[i].baseColor;
-          uint8_t br = (base >> 16) & 0xFF;
-          uint8_t bg = (base >> 8) & 0xFF;
-          uint8_t bb = base & 0xFF;
-
-          for (int j = -5; j <= 5; j++) {
-            int idx = center + j;
-            if (idx < ledStart || idx > ledEnd) continue;
-
-            int brightness = max(0, (int)(255 - abs(j) * 70 - fireworks[i].age * 50 + random(-10, 10)));
-            if (brightness > 0) {
-              uint8_t r = constrain(br + random(-40, 40), 0, 255);
-              uint8_t g = constrain(bg + random(-40, 40), 0, 255);
-              uint8_t b = constrain(bb + random(-40, 40), 0, 255);
-              strip.setPixelColor(idx, strip.Color(r, g, b));
-            }
-          }
-
-          fireworks[i].age++;
-          if (fireworks[i].age > 4) {
-            fireworks[i].active = false;
-            fireworks[i].nextLaunchIn = random(20, 200);
-          }
+      if (len > 20) {
+        uint8_t bursts = 0;
+        for (uint8_t t = 0; t < keyStep; t++) bursts += emitterTick(launcher);
+        for (uint8_t n = bursts; n > 0; n--) {
+          uint32_t c = fireworkColor(rngBelow(6));
+          // Sparkling burst with a 3-pixel glow that fades out over ~25 frames
+          particleSpawn(rngRange(10, len - 10), c, 10, 0, 3, 0, 0, PF_SPARKLE);
         }
       }
-      strip.show();
+      particlesRender(ledStart, len);
+      particlesUpdate(len, keyStep);
       break;
     }
 
     // 🌧 Drizzle
     case DRIZZLE:
-      strip.clear();
+      clearRange(ledStart, ledEnd);
       for (int i = 0; i < 3; i++) {
-        int drop = ledStart + random(activeLEDCount);
-        strip.setPixelColor(drop, strip.Color(0, 50, 255));
+        particleSpawn(rngBelow(len), strip.Color(0, 50, 255), 255);   // single-frame drops
       }
-      strip.show();
+      particlesRender(ledStart, len);
+      particlesUpdate(len, keyStep);
       break;
 
     // ⚡ Flash effect
     case FLASH: {
-      static bool flashState = true;
-      static uint8_t flashCounter = 0;
+      bool& flashState = fx->flash.state;
+      uint8_t& flashCounter = fx->flash.counter;
       const uint8_t maxFlashes = 6;
 
       if (flashState) {
         for (uint16_t i = ledStart; i <= ledEnd; i++) {
-          strip.setPixelColor(i, strip.Color(255, 255, 255)); 
+          setPixel(i, strip.Color(255, 255, 255)); 
         }
       } else {
-        strip.clear();
+        clearRange(ledStart, ledEnd);
       }
 
-      strip.show();
       flashState = !flashState;
       flashCounter++;
       if (flashCounter >= maxFlashes) {
@@ -620,52 +976,57 @@ case BOUNCE_WAVE: {
     // 🌧 Rain
     case RAIN: {
 
-      // 🌧 Always add rain drops for all rain modes
-      for (int i = 0; i < rainIntensity; i++) {
-        int drop = ledStart + random(activeLEDCount);
-        strip.setPixelColor(drop, strip.Color(0, 80, 255));  // normal rain blue
-      }
-
-      // 🌊 Fade old drops for shimmer effect
-      for (int i = ledStart; i <= ledEnd; i++) {
-        uint32_t col = strip.getPixelColor(i);
-        uint8_t r = (col >> 16) & 0xFF;
-        uint8_t g = (col >> 8) & 0xFF;
-        uint8_t b = col & 0xFF;
-        r = (r > 5) ? r - 5 : 0;
-        g = (g > 5) ? g - 5 : 0;
-        b = (b > 10) ? b - 10 : 0;
-        strip.setPixelColor(i, r, g, b);
+      // 🌊 Drops are particles that fade out over ~25 frames (shimmer)
+      clearRange(ledStart, ledEnd);
+
+      // 🌧 Always add rain drops for all rain modes (palette-colored if one is set)
+      uint8_t dropFlags = paletteActive() ? PF_PALETTE : 0;
+      bool panel = matrixActive();
+      if (panel) {
+        // 🔲 Drops fall down the columns instead (≈ rainIntensity / 5 per frame)
+        ParticleEmitter& drops = fx->drops;
+        drops.rate = rainIntensity * ((rainMode == "thunderstorm") ? 240 : 48);
+        for (uint8_t n = emitterTick(drops); n > 0; n--) {
+          bool bright = (rainMode == "thunderstorm") && rngRange(0, 8) == 0;
+          matrixRainDrop(bright ? strip.Color(120, 180, 255) : strip.Color(0, 80, 255), dropFlags);
+        }
+      } else {
+        for (int i = 0; i < govScale(rainIntensity); i++) {
+          particleSpawn(rngBelow(len), strip.Color(0, 80, 255), 10, 0, 0, 0, 0, dropFlags);  // normal rain blue
+        }
       }
 
       // ⚡ Lightning system used for BOTH heavy rain & thunderstorm
-      static uint8_t stage = 0;
-      static uint8_t flickerCount = 0;
-      static unsigned long nextEvent = 0;
-      static uint8_t strikeType = 0; // 0=small, 1=vein, 2=big
-      static uint8_t bigThunderCounter = 0;
+      uint8_t& stage = fx->rain.stage;
+      uint8_t& flickerCount = fx->rain.flickerCount;
+      unsigned long& nextEvent = fx->rain.nextEvent;
+      uint8_t& strikeType = fx->rain.strikeType; // 0=small, 1=vein, 2=big
+      uint8_t& bigThunderCounter = fx->rain.bigThunderCounter;
 
       // ⚡ Trigger conditions
       bool triggerLightning = false;
       if (rainMode == "thunderstorm") {
           triggerLightning = true;   // always active
-      } else if (rainMode == "heavy" && random(0, 100) == 0) {  // rare lightning in heavy rain
+      } else if (rainMode == "heavy" && rngRange(0, 100) == 0) {  // rare lightning in heavy rain
           triggerLightning = true;
       }
 
       // 🌊 Add extra rain ONLY in thunderstorm mode (4× intensity)
-      if (rainMode == "thunderstorm") {
-          for (int i = 0; i < rainIntensity * 4; i++) {
-            int drop = ledStart + random(activeLEDCount);
+      if (rainMode == "thunderstorm" && !panel) {
+          for (int i = 0; i < govScale(rainIntensity * 4); i++) {
+            int drop = rngBelow(len);
             // occasional brighter “storm blue” drops
-            if (random(0, 8) == 0) {
-              strip.setPixelColor(drop, strip.Color(120, 180, 255));  // bright storm blue
+            if (rngRange(0, 8) == 0) {
+              particleSpawn(drop, strip.Color(120, 180, 255), 10);  // bright storm blue
             } else {
-              strip.setPixelColor(drop, strip.Color(0, 100, 255));    // normal storm blue
+              particleSpawn(drop, strip.Color(0, 100, 255), 10);    // normal storm blue
             }
           }
       }
 
+      particlesRender(ledStart, len);
+      particlesUpdate(len, keyStep);
+
       // ⚡ Run lightning effect if triggered
       if (triggerLightning && millis() > nextEvent) {
 
@@ -676,9 +1037,9 @@ case BOUNCE_WAVE: {
               strikeType = 2;  // 🌩 Big thunder every 4th strike
               bigThunderCounter = 0;
             } else {
-              strikeType = random(0, 2); // 0=small, 1=vein
+              strikeType = rngRange(0, 2); // 0=small, 1=vein
             }
-            flickerCount = (strikeType == 2) ? random(3, 6) : random(2, 4); 
+            flickerCount = govScale((strikeType == 2) ? rngRange(3, 6) : rngRange(2, 4));
             stage = 1;
             break;
           }
@@ -686,21 +1047,21 @@ case BOUNCE_WAVE: {
           case 1: {  
             // ⚡ Pre-flickers before main strike
             if (flickerCount > 0) {
-              uint8_t brightness = random(50, 180);
-              int segStart = ledStart + random(activeLEDCount - 30);
-              int segEnd = segStart + random(10, 40);
+              uint8_t brightness = rngRange(50, 180);
+              int segStart = ledStart + rngBelow(activeLEDCount - 30);
+              int segEnd = segStart + rngRange(10, 40);
 
               for (int i = segStart; i <= segEnd && i <= ledEnd; i++) {
-                strip.setPixelColor(i, strip.Color(brightness, brightness, brightness));
+                setPixel(i, strip.Color(brightness, brightness, brightness));
               }
-              strip.show();
+              effectCommit();
 
-              delay(30);
-              strip.clear();
-              strip.show();
+              effectDelay(30);
+              clearRange(ledStart, ledEnd);
+              effectCommit();
 
               flickerCount--;
-              nextEvent = millis() + random(50, 120);
+              nextEvent = millis() + rngRange(50, 120);
             } else {
               stage = 2;
             }
@@ -711,80 +1072,79 @@ case BOUNCE_WAVE: {
             // ⚡ Main strike types
             if (strikeType == 0) {
               // Small segment lightning
-              int segStart = ledStart + random(activeLEDCount - 50);
-              int segEnd = segStart + random(20, 80);
+              int segStart = ledStart + rngBelow(activeLEDCount - 50);
+              int segEnd = segStart + rngRange(20, 80);
               for (int i = segStart; i <= segEnd && i <= ledEnd; i++) {
-                strip.setPixelColor(i, strip.Color(255, 255, 255));
+                setPixel(i, strip.Color(255, 255, 255));
               }
             } 
             else if (strikeType == 1) {
               // 🌩 Vein lightning
-              int startPos = ledStart + random(activeLEDCount - 20);
-              for (int v = 0; v < random(6, 12); v++) {
-                int branchLength = random(5, 12);         
-                int direction = (random(0, 2) == 0) ? 1 : -1;
+              int startPos = ledStart + rngBelow(activeLEDCount - 20);
+              for (int v = 0; v < govScale(rngRange(6, 12)); v++) {
+                int branchLength = rngRange(5, 12);         
+                int direction = (rngRange(0, 2) == 0) ? 1 : -1;
 
                 for (int i = 0; i < branchLength; i++) {
                   int index = startPos + (i * direction);
                   if (index >= ledStart && index <= ledEnd) {
-                    if (random(0, 3) == 0) {
-                      strip.setPixelColor(index, strip.Color(180, 220, 255)); 
+                    if (rngRange(0, 3) == 0) {
+                      setPixel(index, strip.Color(180, 220, 255)); 
                     } else {
-                      strip.setPixelColor(index, strip.Color(255, 255, 255)); 
+                      setPixel(index, strip.Color(255, 255, 255)); 
                     }
-                    if (index + 1 <= ledEnd) strip.setPixelColor(index + 1, strip.Color(150, 200, 255));
-                    if (index - 1 >= ledStart) strip.setPixelColor(index - 1, strip.Color(150, 200, 255));
+                    if (index + 1 <= ledEnd) setPixel(index + 1, strip.Color(150, 200, 255));
+                    if (index - 1 >= ledStart) setPixel(index - 1, strip.Color(150, 200, 255));
                   }
                 }
-                startPos += random(-8, 8);
+                startPos += rngRange(-8, 8);
                 if (startPos < ledStart) startPos = ledStart;
                 if (startPos > ledEnd) startPos = ledEnd;
               }
-              strip.show();
-              delay(100);
-              strip.clear();
-              strip.show();
+              effectCommit();
+              effectDelay(100);
+              clearRange(ledStart, ledEnd);
+              effectCommit();
             }
             else if (strikeType == 2) {
               // 🌩 Big thunder: full strip
               for (uint16_t i = ledStart; i <= ledEnd; i++) {
-                strip.setPixelColor(i, strip.Color(255, 255, 255));
+                setPixel(i, strip.Color(255, 255, 255));
               }
             }
 
-            strip.show();
-            delay((strikeType == 2) ? 120 : 60);
-            strip.clear();
-            strip.show();
+            effectCommit();
+            effectDelay((strikeType == 2) ? 120 : 60);
+            clearRange(ledStart, ledEnd);
+            effectCommit();
 
             stage = 3;
-            nextEvent = millis() + random(100, 500);
+            nextEvent = millis() + rngRange(100, 500);
             break;
           }
 
           case 3: {  
             // 🌫 Afterglow
-            if (random(0, 2)) {  
-              uint8_t afterGlow = random(50, 120);
-              int afterSegStart = ledStart + random(activeLEDCount - 30);
-              int afterSegEnd = afterSegStart + random(10, 30);
+            if (rngRange(0, 2)) {  
+              uint8_t afterGlow = rngRange(50, 120);
+              int afterSegStart = ledStart + rngBelow(activeLEDCount - 30);
+              int afterSegEnd = afterSegStart + rngRange(10, 30);
               for (int i = afterSegStart; i <= afterSegEnd && i <= ledEnd; i++) {
-                strip.setPixelColor(i, strip.Color(afterGlow, afterGlow, afterGlow));
+                setPixel(i, strip.Color(afterGlow, afterGlow, afterGlow));
               }
-              strip.show();
+              effectCommit();
 
-              delay(40);
-              strip.clear();
-              strip.show();
+              effectDelay(40);
+              clearRange(ledStart, ledEnd);
+              effectCommit();
             }
             stage = 0;
-            nextEvent = millis() + ((strikeType == 2) ? random(4000, 7000) : random(2000, 5000)); 
+            nextEvent = millis() + ((strikeType == 2) ? rngRange(4000, 7000) : rngRange(2000, 5000)); 
             break;
           }
         }
       }
 
-      strip.show();
       break;
     }
 
@@ -792,4 +1152,8 @@ case BOUNCE_WAVE: {
     default:
       break;
   }
+
+  if (loop) loopCacheStore(*loop, loopPos, ledStart);
+  if (fxSymPixels) symmetryExpand(fxFullEnd);
+  endLayer();
 }
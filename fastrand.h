@@ -0,0 +1,71 @@
+#pragma once
+// =====================
+// 🎲 FAST RANDOM MODULE
+// =====================
+//
+// xorshift32 generator for effects. Arduino random() goes through libc /
+// esp_random() and a modulo on every call; effects call it per pixel, so
+// this one is inline, division-free, and seedable (CMD:SEED=n) to make
+// effect frames reproducible.
+//
+// Ranges follow Arduino random(): rngBelow(n) → [0, n), rngRange(lo, hi)
+// → [lo, hi), and an empty range returns its lower bound. The byte helpers
+// are inclusive like random8(lo, hi + 1) callers expect: rngByteRange(b, 0,
+// 255) covers every byte.
+//
+
+uint32_t rngState = 0x9E3779B9;
+
+inline void rngSeed(uint32_t seed) {
+  rngState = seed ? seed : 0x9E3779B9;   // xorshift must never hold 0
+}
+
+inline uint32_t rngNext() {
+  uint32_t x = rngState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return rngState = x;
+}
+
+// [0, n) via multiply-shift (no modulo)
+inline int32_t rngBelow(int32_t n) {
+  if (n <= 0) return 0;
+  return (int32_t)(((uint64_t)rngNext() * (uint32_t)n) >> 32);
+}
+
+inline int32_t rngRange(int32_t lo, int32_t hi) {
+  return (hi > lo) ? lo + rngBelow(hi - lo) : lo;
+}
+
+// Scale a random byte into [lo, hi] without a multiply-wide or modulo
+inline uint8_t rngByteRange(uint8_t byte, uint8_t lo, uint8_t hi) {
+  if (hi <= lo) return lo;
+  return lo + (uint8_t)(((uint16_t)byte * (uint16_t)(hi - lo + 1)) >> 8);
+}
+
+// ======================
+// 📦 BULK HELPERS
+// ======================
+// One generator step feeds four output bytes.
+
+void rngFill(uint8_t* buf, uint16_t n) {
+  uint16_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint32_t r = rngNext();
+    buf[i]     = r;
+    buf[i + 1] = r >> 8;
+    buf[i + 2] = r >> 16;
+    buf[i + 3] = r >> 24;
+  }
+  if (i < n) {
+    uint32_t r = rngNext();
+    for (; i < n; i++, r >>= 8) buf[i] = r;
+  }
+}
+
+// Fill with bytes in [lo, hi]
+void rngFillRange(uint8_t* buf, uint16_t n, uint8_t lo, uint8_t hi) {
+  rngFill(buf, n);
+  for (uint16_t i = 0; i < n; i++) buf[i] = rngByteRange(buf[i], lo, hi);
+}
@@ -0,0 +1,133 @@
+#pragma once
+// =====================
+// 🎚 QUALITY GOVERNOR MODULE
+// =====================
+//
+// Keeps the frame rate steady on long strips by trading detail for time.
+// loop() measures each pass that did work (render, strip show(), OLED) and
+// keeps a running average. While that sits over the budget the governor
+// steps down one quality level at a time; with clear headroom for a while
+// it steps back up. Each level is one row of GOV_LEVELS:
+//
+//   quality      effect detail, read through govScale(): STAR_RAIN
+//                sparkles, RAIN drops and lightning complexity
+//   keyStepMs    keyframe interpolation refresh (effects.h)
+//   oledMs       OLED refresh interval (0 = every pass)
+//   particleCap  live particles before the pool recycles (particles.h)
+//
+// Intentional pauses (the blocking lightning flashes) go through
+// effectDelay() and don't count as frame time.
+//
+//   CMD:GOVERNOR=ON | OFF | STATS | <budget ms>
+//
+
+#define GOV_BUDGET_US   20000   // default frame budget (50 fps)
+#define GOV_DOWN_PASSES 8       // consecutive passes over budget before a step down
+#define GOV_UP_PASSES   180     // passes under GOV_UP_PCT of budget before a step up
+#define GOV_UP_PCT      60
+
+struct GovLevel {
+  uint8_t quality;
+  uint8_t keyStepMs;
+  uint8_t oledMs;
+  uint8_t particleCap;
+};
+
+const GovLevel GOV_LEVELS[] = {
+  { 255, 16,  0,   192 },   // full detail, ≈60 fps interpolation
+  { 192, 33,  33,  144 },
+  { 128, 50,  66,  96  },
+  { 64,  100, 100, 48  },
+};
+const uint8_t GOV_LEVEL_COUNT = sizeof(GOV_LEVELS) / sizeof(GOV_LEVELS[0]);
+
+bool govEnabled = true;
+uint8_t govLevel = 0;
+uint32_t govBudgetUs = GOV_BUDGET_US;
+
+// Pass measurement
+uint32_t govPassStart = 0;
+uint32_t govPausedUs = 0;        // effectDelay() time inside this pass
+bool govWork = false;            // this pass pushed the strip or the OLED
+unsigned long govLastOled = 0;
+
+// Telemetry
+uint32_t govAvgUs = 0;           // running average, 1/8 per pass
+uint32_t govMaxUs = 0;           // worst pass since the last STATS
+uint16_t govOver = 0, govUnder = 0;
+uint32_t govStepsDown = 0, govStepsUp = 0;
+
+inline const GovLevel& gov() { return GOV_LEVELS[govLevel]; }
+
+// n scaled by the current quality (at least 1 while n > 0)
+inline int govScale(int n) {
+  if (n <= 0) return n;
+  int s = n * gov().quality / 255;
+  return s ? s : 1;
+}
+
+// delay() that the frame measurement leaves out
+inline void effectDelay(uint32_t ms) {
+  uint32_t t0 = micros();
+  delay(ms);
+  govPausedUs += micros() - t0;
+}
+
+// OLED refresh due this pass (and counted as work)
+bool govOledDue() {
+  unsigned long now = millis();
+  if (gov().oledMs && now - govLastOled < gov().oledMs) return false;
+  govLastOled = now;
+  govWork = true;
+  return true;
+}
+
+inline void govBegin() {
+  govPassStart = micros();
+  govPausedUs = 0;
+  govWork = false;
+}
+
+void govSetLevel(uint8_t level, uint32_t avgUs) {
+  if (level > govLevel) govStepsDown++;
+  else govStepsUp++;
+  govLevel = level;
+  govOver = govUnder = 0;
+  Serial.print("🎚 Governor: level "); Serial.print(govLevel);
+  Serial.print(" (frame "); Serial.print(avgUs / 1000.0f, 1);
+  Serial.print(" ms, budget "); Serial.print(govBudgetUs / 1000.0f, 1); Serial.println(" ms)");
+}
+
+// End of loop(): account the pass and adjust the level
+void govEnd() {
+  if (!govWork) return;   // nothing rendered or drawn: not a frame
+  uint32_t us = micros() - govPassStart - govPausedUs;
+  govAvgUs = govAvgUs ? govAvgUs + ((int32_t)(us - govAvgUs) >> 3) : us;
+  if (us > govMaxUs) govMaxUs = us;
+  if (!govEnabled) return;
+
+  if (govAvgUs > govBudgetUs) {
+    govUnder = 0;
+    if (++govOver >= GOV_DOWN_PASSES && govLevel + 1 < GOV_LEVEL_COUNT) govSetLevel(govLevel + 1, govAvgUs);
+  } else if (govAvgUs < govBudgetUs * GOV_UP_PCT / 100) {
+    govOver = 0;
+    if (++govUnder >= GOV_UP_PASSES && govLevel > 0) govSetLevel(govLevel - 1, govAvgUs);
+  } else {
+    govOver = govUnder = 0;
+  }
+}
+
+void govPrintStats() {
+  Serial.print("🎚 Governor: "); Serial.print(govEnabled ? "ON" : "OFF");
+  Serial.print(" | level "); Serial.print(govLevel); Serial.print("/"); Serial.print(GOV_LEVEL_COUNT - 1);
+  Serial.print(" | budget "); Serial.print(govBudgetUs / 1000.0f, 1); Serial.println(" ms");
+  Serial.print("   frame avg="); Serial.print(govAvgUs / 1000.0f, 2);
+  Serial.print("ms max="); Serial.print(govMaxUs / 1000.0f, 2);
+  Serial.print("ms | steps down="); Serial.print(govStepsDown);
+  Serial.print(" up="); Serial.println(govStepsUp);
+  Serial.print("   quality="); Serial.print(gov().quality);
+  Serial.print(" interp="); Serial.print(gov().keyStepMs);
+  Serial.print("ms oled="); Serial.print(gov().oledMs);
+  Serial.print("ms particles="); Serial.println(gov().particleCap);
+  govMaxUs = 0;
+}
@@ -0,0 +1,169 @@
+#pragma once
+// =====================
+// 💤 IDLE MODULE
+// =====================
+//
+// Fast path for always-on installs showing a static scene. Once nothing has
+// animated for IDLE_ENTER_MS (no effect on the strip or any zone, no scroll,
+// crossfade, overlay notification or OLED status message, nothing dirty),
+// loop() stops rendering: the eyes are redrawn every IDLE_OLED_MS instead of
+// at full rate, and the loop task sleeps between those redraws.
+//
+// On ESP32 the sleep is a FreeRTOS task-notify wait that a UART receive
+// callback cuts short, so a command is picked up as soon as it arrives.
+// Elsewhere it falls back to short delay() polls. In the dual-core layout
+// (tasks.h) the UI task keeps the eyes going and does the waking, after
+// queueing the command.
+//
+// Telemetry: share of wall time spent asleep (rolling IDLE_WINDOW_MS
+// window) and wake latency, byte arrival → loop running again.
+//
+//   CMD:LEDIDLE=ON | OFF  enable/disable the fast path (default ON)
+//   CMD:LEDIDLE=STATS     print the telemetry
+//   (plain CMD:IDLE= belongs to the eyes, Billu_RoboEyes_EmoPack.h)
+//
+
+#define IDLE_ENTER_MS   2000    // static this long before the loop sleeps
+#define IDLE_OLED_MS    100     // eyes refresh while idle (10 fps)
+#define IDLE_POLL_MS    5       // sleep slice without a wake callback
+#define IDLE_WINDOW_MS  10000   // idle-percentage window
+
+// from commands.h
+extern int queueStart, queueEnd;
+
+bool idleEnabled = true;
+bool idling = false;
+unsigned long idleSince = 0;         // scene static since (ms)
+unsigned long idleLastOled = 0;
+
+// Telemetry
+unsigned long idleWindowStart = 0;   // ms
+uint32_t idleWindowSleptUs = 0;
+uint8_t idlePct = 0;                 // last full window
+uint32_t idleWakes = 0;
+uint32_t idleWakeLastUs = 0, idleWakeMaxUs = 0;
+uint64_t idleWakeTotalUs = 0;
+
+std::atomic<uint32_t> idleRxStamp{0};   // micros() of the byte that woke us (0 = none)
+
+#if defined(ARDUINO_ARCH_ESP32)
+TaskHandle_t idleTask = nullptr;
+#endif
+
+// UART event task (or UI task) context: stamp and wake the loop task
+void idleOnReceive() {
+  uint32_t none = 0;
+  idleRxStamp.compare_exchange_strong(none, micros() | 1);
+#if defined(ARDUINO_ARCH_ESP32)
+  if (idleTask) xTaskNotifyGive(idleTask);
+#endif
+}
+
+void idleBegin() {
+#if defined(ARDUINO_ARCH_ESP32)
+  idleTask = xTaskGetCurrentTaskHandle();
+#if !DUAL_CORE
+  Serial.onReceive(idleOnReceive);
+#endif
+#endif
+  idleSince = idleWindowStart = millis();
+}
+
+// Commands waiting for the render loop
+inline bool commandsPending() {
+#if DUAL_CORE
+  return !cmdRing.empty();
+#else
+  return queueStart != queueEnd || Serial.available();
+#endif
+}
+
+// Nothing on the LEDs or the OLED would change if we skipped this pass
+bool idleSceneStatic() {
+  if (currentEffect != NONE || scrollMode || zoneEffectsRunning || animPlaying) return false;
+  if (transitionActive || frameDirty || outLUTStale) return false;
+  if (layers[LAYER_OVERLAY].visible) return false;
+#if !DUAL_CORE
+  if (animator.isBusy()) return false;     // dual-core: the UI task animates on its own
+#endif
+  return !commandsPending();
+}
+
+void idleSleep(uint32_t ms) {
+  uint32_t t0 = micros();
+#if defined(ARDUINO_ARCH_ESP32)
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+#else
+  // No receive callback: poll in short slices, stamp arrival on detection
+  while (ms && !commandsPending()) {
+    uint32_t step = (ms < IDLE_POLL_MS) ? ms : IDLE_POLL_MS;
+    delay(step);
+    ms -= step;
+  }
+  if (commandsPending()) {
+    uint32_t none = 0;
+    idleRxStamp.compare_exchange_strong(none, micros() | 1);
+  }
+#endif
+  idleWindowSleptUs += micros() - t0;
+}
+
+void idleAccount(unsigned long now) {
+  unsigned long span = now - idleWindowStart;
+  if (span < IDLE_WINDOW_MS) return;
+  uint32_t pct = idleWindowSleptUs / (span * 10UL);   // µs / (ms * 1000) * 100
+  idlePct = (pct > 100) ? 100 : pct;
+  idleWindowSleptUs = 0;
+  idleWindowStart = now;
+}
+
+void idleWake() {
+  idling = false;
+  uint32_t stamp = idleRxStamp.exchange(0);
+  if (!stamp) return;
+  uint32_t lat = micros() - stamp;
+  idleWakes++;
+  idleWakeLastUs = lat;
+  idleWakeTotalUs += lat;
+  if (lat > idleWakeMaxUs) idleWakeMaxUs = lat;
+}
+
+// Called first thing in loop(). Returns true if this pass was handled here
+// (slept), false if the normal loop body should run.
+bool idleTick() {
+  unsigned long now = millis();
+  idleAccount(now);
+
+  if (!idleEnabled || !idleSceneStatic()) {
+    if (idling) idleWake();
+    idleRxStamp = 0;
+    idleSince = now;
+    return false;
+  }
+  if (!idling) {
+    if (now - idleSince < IDLE_ENTER_MS) return false;
+    idling = true;
+    idleLastOled = now;
+  }
+
+  if (now - idleLastOled >= IDLE_OLED_MS) {
+    idleLastOled = now;
+#if !DUAL_CORE
+    Eyes_update();
+    lcd.flush();
+#endif
+  }
+  uint32_t left = IDLE_OLED_MS - (millis() - idleLastOled);
+  if (left > IDLE_OLED_MS) left = 0;   // overran the slot
+  idleSleep(left);
+  return true;
+}
+
+void idlePrintStats() {
+  Serial.print("💤 Idle: "); Serial.print(idleEnabled ? (idling ? "sleeping" : "awake") : "off");
+  Serial.print(" | "); Serial.print(idlePct); Serial.println("% of the last window");
+  Serial.print("   wakes="); Serial.print(idleWakes);
+  Serial.print(" latency last="); Serial.print(idleWakeLastUs);
+  Serial.print("us avg="); Serial.print(idleWakes ? (uint32_t)(idleWakeTotalUs / idleWakes) : 0);
+  Serial.print("us max="); Serial.print(idleWakeMaxUs); Serial.println("us");
+}
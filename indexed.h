@@ -0,0 +1,182 @@
+#pragma once
+// =====================
+// 🗜 INDEXED BASE MODULE
+// =====================
+//
+// 8-bit indexed copies of the static picture. Stripe, split, block and fill
+// renders only ever use a handful of colors, and a gradient is nothing but
+// palette LUT entries, so the stores that keep a static picture around (the
+// wave/scroll base, each zone's base slice, the base frame cache) hold one
+// index byte per LED plus a color table instead of a 0x00RRGGBB word: about
+// a quarter of the RAM per LED. Colors come back out only where a pixel is
+// read (expand, wave modulation, scroll bake).
+//
+// The color table is either the store's own (up to INDEXED_OWN_MAX colors)
+// or a palette LUT it points at. A picture that is neither (over
+// INDEXED_OWN_MAX colors that aren't palette entries, e.g. an animation
+// frame under a wave) is mapped to the nearest of its first
+// INDEXED_OWN_MAX colors, and indexedEncode() reports it as inexact.
+// indexedStore() never keeps that approximation: it falls back to a
+// verbatim RGB copy on the heap, held only while the picture needs it.
+//
+// A LUT pointed at is the live palette table. paletteBuild() detaches the
+// stores reading through it first (indexedDetach()), so a rebuild doesn't
+// recolor a picture that was captured before it.
+//
+
+#define INDEXED_OWN_MAX 32
+
+struct IndexedBase {
+  uint8_t* idx;                     // caller-owned, one byte per LED
+  const uint32_t* lut;              // palette LUT, or nullptr for own[]
+  uint32_t own[INDEXED_OWN_MAX];
+  uint8_t ownCount;
+  uint32_t* rgb;                    // exact copy instead of idx (indexedStore), or nullptr
+  uint16_t rgbCap;
+  uint32_t hash;                    // of the pixels as captured (cache keys, loopcache.h)
+  uint16_t len;                     // pixels held
+
+  inline const uint32_t* colors() const { return lut ? lut : own; }
+  inline uint32_t operator[](uint16_t i) const { return rgb ? rgb[i] : colors()[idx[i]]; }
+};
+
+// Sum of per-channel differences
+inline uint16_t indexedDistance(uint32_t a, uint32_t b) {
+  int dr = (int)((a >> 16) & 0xFF) - (int)((b >> 16) & 0xFF);
+  int dg = (int)((a >> 8) & 0xFF) - (int)((b >> 8) & 0xFF);
+  int db = (int)(a & 0xFF) - (int)(b & 0xFF);
+  return abs(dr) + abs(dg) + abs(db);
+}
+
+// FNV-1a over the pixels, one word at a time
+uint32_t indexedHash(const uint32_t* src, uint16_t n) {
+  uint32_t h = 2166136261UL;
+  for (uint16_t i = 0; i < n; i++) { h ^= src[i]; h *= 16777619UL; }
+  return h;
+}
+
+// src[0..n) → b. lut: the palette a gradient may have been drawn from
+// (nullable). Returns false if colors had to be approximated.
+bool indexedEncode(IndexedBase& b, const uint32_t* src, uint16_t n, const uint32_t* lut) {
+  b.hash = indexedHash(src, n);
+  b.len = n;
+  // 1) Few distinct colors: own table
+  b.lut = nullptr;
+  b.ownCount = 0;
+  uint16_t i = 0;
+  for (; i < n; i++) {
+    uint8_t k = 0;
+    while (k < b.ownCount && b.own[k] != src[i]) k++;
+    if (k == b.ownCount) {
+      if (b.ownCount == INDEXED_OWN_MAX) break;
+      b.own[b.ownCount++] = src[i];
+    }
+    b.idx[i] = k;
+  }
+  if (i == n) return true;
+
+  // 2) Palette content: search the LUT from the last hit (a gradient walks it)
+  if (lut) {
+    uint8_t at = 0;
+    uint16_t j = 0;
+    for (; j < n; j++) {
+      uint16_t s = 0;
+      while (s < 256 && lut[(uint8_t)(at + s)] != src[j]) s++;
+      if (s == 256) break;
+      at += s;
+      b.idx[j] = at;
+    }
+    if (j == n) {
+      b.lut = lut;
+      return true;
+    }
+  }
+
+  // 3) Anything else: nearest of the first INDEXED_OWN_MAX colors
+  for (uint16_t j = 0; j < n; j++) {
+    uint8_t best = 0;
+    uint16_t bestD = 0xFFFF;
+    for (uint8_t k = 0; k < b.ownCount && bestD; k++) {
+      uint16_t d = indexedDistance(b.own[k], src[j]);
+      if (d < bestD) { bestD = d; best = k; }
+    }
+    b.idx[j] = best;
+  }
+  return false;
+}
+
+// Back to indexed: release the RGB copy
+void indexedDropRgb(IndexedBase& b) {
+  free(b.rgb);
+  b.rgb = nullptr;
+  b.rgbCap = 0;
+}
+
+// Exact src[0..n) → b: indexed when it fits, else an RGB copy. Returns
+// false only if that copy couldn't be allocated (b is then approximate).
+bool indexedStore(IndexedBase& b, const uint32_t* src, uint16_t n, const uint32_t* lut) {
+  if (indexedEncode(b, src, n, lut)) {
+    indexedDropRgb(b);
+    return true;
+  }
+  if (b.rgbCap < n) {
+    indexedDropRgb(b);
+    b.rgb = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (!b.rgb) return false;
+    b.rgbCap = n;
+  }
+  memcpy(b.rgb, src, n * sizeof(uint32_t));
+  return true;
+}
+
+// First n pixels of an indexed src → dst (both stores already own their idx storage)
+void indexedCopy(IndexedBase& dst, const IndexedBase& src, uint16_t n) {
+  indexedDropRgb(dst);
+  memcpy(dst.idx, src.idx, n);
+  dst.lut = src.lut;
+  dst.ownCount = src.ownCount;
+  dst.hash = src.hash;
+  dst.len = n;
+  memcpy(dst.own, src.own, src.ownCount * sizeof(uint32_t));
+}
+
+// lut is about to be rebuilt: if b reads through it, keep the colors b
+// shows as an RGB copy. Without RAM for one, b keeps every 8th LUT entry in
+// own[] (a gradient stays a coarser gradient) and false is returned.
+bool indexedDetach(IndexedBase& b, const uint32_t* lut) {
+  if (!lut || b.rgb || b.lut != lut) return true;
+  b.lut = nullptr;
+  uint32_t* rgb = (uint32_t*)malloc(b.len * sizeof(uint32_t));
+  if (rgb) {
+    for (uint16_t i = 0; i < b.len; i++) rgb[i] = lut[b.idx[i]];
+    b.rgb = rgb;
+    b.rgbCap = b.len;
+    return true;
+  }
+  for (uint8_t k = 0; k < INDEXED_OWN_MAX; k++) b.own[k] = lut[k * (256 / INDEXED_OWN_MAX)];
+  b.ownCount = INDEXED_OWN_MAX;
+  for (uint16_t i = 0; i < b.len; i++) b.idx[i] /= 256 / INDEXED_OWN_MAX;
+  return false;
+}
+
+// b[0..n) → RGB
+void indexedExpand(uint32_t* dst, const IndexedBase& b, uint16_t n) {
+  if (b.rgb) { memcpy(dst, b.rgb, n * sizeof(uint32_t)); return; }
+  const uint32_t* pal = b.colors();
+  for (uint16_t i = 0; i < n; i++) dst[i] = pal[b.idx[i]];
+}
+
+// dst[i] = b[i] scaled by levels[i]/255 for i in [from, to) (the wave
+// effects' modulation, one slice of it when split across cores)
+void indexedScaleSlice(uint32_t* dst, const IndexedBase& b, const uint8_t* levels, uint16_t from, uint16_t to) {
+  if (b.rgb) {
+    for (uint16_t i = from; i < to; i++) dst[i] = pkSwarScale1(b.rgb[i], (uint16_t)levels[i] + 1);
+    return;
+  }
+  const uint32_t* pal = b.colors();
+  for (uint16_t i = from; i < to; i++) dst[i] = pkSwarScale1(pal[b.idx[i]], (uint16_t)levels[i] + 1);
+}
+
+void indexedScaleEach(uint32_t* dst, const IndexedBase& b, const uint8_t* levels, uint16_t n) {
+  indexedScaleSlice(dst, b, levels, 0, n);
+}
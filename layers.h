@@ -0,0 +1,196 @@
+#pragma once
+// =====================
+// 🧅 LAYER COMPOSITOR MODULE
+// =====================
+//
+// Optional three-layer stack, merged into frame[] in one fused pass at
+// commit time (only over the dirty range):
+//
+//   LAYER_BASE     static pattern / scroll (patterns.h, colors.h, fillAll)
+//   LAYER_EFFECT   runCurrentEffect() output, shown while an effect is set
+//   LAYER_OVERLAY  transient notifications (CMD:NOTIFY), fades out
+//
+// Layers above the base have a blend mode (replace, add-saturate, max,
+// multiply) and an opacity. With the effect layer on "add", rain runs over
+// a scrolling gradient instead of replacing it.
+//
+// Off by default: everything draws straight into frame[] and none of this
+// runs. CMD:LAYER=... turns it on, CMD:LAYER=OFF goes back to one buffer.
+// A notification turns it on for its own duration when needed.
+//
+
+enum LayerId { LAYER_BASE, LAYER_EFFECT, LAYER_OVERLAY, LAYER_COUNT };
+enum BlendMode { BLEND_REPLACE, BLEND_ADD, BLEND_MAX, BLEND_MULTIPLY };
+
+struct Layer {
+  BlendMode mode;
+  uint8_t opacity;
+  bool visible;
+};
+
+uint32_t* layerBuf[LAYER_COUNT];   // numLeds each, from the strip arena
+Layer layers[LAYER_COUNT] = {
+  { BLEND_REPLACE, 255, true  },
+  { BLEND_REPLACE, 255, false },
+  { BLEND_ADD,     255, false },
+};
+
+// from zones.h
+extern bool zoneEffectsRunning;
+
+bool layeringEnabled = false;
+bool layeringAuto = false;       // turned on by a notification, not by the user
+
+// Overlay notification timing
+unsigned long overlayStart = 0;
+uint16_t overlayMs = 0;
+uint8_t overlayFade = 255;       // multiplies the overlay opacity while it fades
+
+// ======================
+// 🎛 BLENDING
+// ======================
+inline uint8_t blendChannel(uint8_t dst, uint8_t src, BlendMode mode, uint16_t k) {
+  switch (mode) {
+    case BLEND_ADD: {
+      uint16_t v = dst + ((src * k) >> 8);
+      return (v > 255) ? 255 : v;
+    }
+    case BLEND_MAX: {
+      uint8_t s = (src * k) >> 8;
+      return (s > dst) ? s : dst;
+    }
+    case BLEND_MULTIPLY: {
+      uint8_t m = (dst * (src + 1)) >> 8;
+      return dst + ((((int)m - dst) * (int)k) >> 8);
+    }
+    case BLEND_REPLACE:
+    default:
+      return dst + ((((int)src - dst) * (int)k) >> 8);
+  }
+}
+
+inline uint32_t blendPixel(uint32_t dst, uint32_t src, BlendMode mode, uint8_t opacity) {
+  if (mode == BLEND_REPLACE && opacity == 255) return src;
+  if (!src && (mode == BLEND_ADD || mode == BLEND_MAX)) return dst;
+  uint16_t k = (uint16_t)opacity + 1;
+  return ((uint32_t)blendChannel((dst >> 16) & 0xFF, (src >> 16) & 0xFF, mode, k) << 16) |
+         ((uint32_t)blendChannel((dst >> 8) & 0xFF, (src >> 8) & 0xFF, mode, k) << 8) |
+         blendChannel(dst & 0xFF, src & 0xFF, mode, k);
+}
+
+// Fused pass: base + every visible upper layer → frame[from..to]
+void compositeLayers(uint16_t from, uint16_t to) {
+  if (to >= numLeds) to = numLeds - 1;
+
+  const uint32_t* src[LAYER_COUNT];
+  BlendMode mode[LAYER_COUNT];
+  uint8_t opacity[LAYER_COUNT];
+  uint8_t n = 0;
+  for (uint8_t l = LAYER_EFFECT; l < LAYER_COUNT; l++) {
+    uint8_t op = layers[l].opacity;
+    if (l == LAYER_OVERLAY) op = (op * (overlayFade + 1)) >> 8;
+    if (!layers[l].visible || !op) continue;
+    src[n] = layerBuf[l];
+    mode[n] = layers[l].mode;
+    opacity[n] = op;
+    n++;
+  }
+
+  const uint32_t* base = layerBuf[LAYER_BASE];
+  uint8_t baseOpacity = layers[LAYER_BASE].opacity;
+  for (uint16_t i = from; i <= to; i++) {
+    uint32_t b = viewPixel(base, i);   // scroll reads the base in place
+    uint32_t out = (baseOpacity == 255) ? b : scaleColor(b, baseOpacity);
+    for (uint8_t k = 0; k < n; k++) out = blendPixel(out, src[k][i], mode[k], opacity[k]);
+    frame[i] = out;
+  }
+}
+
+// ======================
+// 🔀 LAYER TARGETS
+// ======================
+inline void beginLayer(LayerId id) {
+  if (layeringEnabled) drawTarget = layerBuf[id];
+}
+
+inline void endLayer() {
+  drawTarget = layeringEnabled ? layerBuf[LAYER_BASE] : frame;
+}
+
+// The static picture effects like WAVE modulate
+inline uint32_t* baseBuffer() {
+  return layeringEnabled ? layerBuf[LAYER_BASE] : frame;
+}
+
+void setLayering(bool on) {
+  if (on == layeringEnabled) return;
+  if (on) {
+    // Current picture becomes the base; upper layers start empty
+    memcpy(layerBuf[LAYER_BASE], frame, numLeds * sizeof(uint32_t));
+    memset(layerBuf[LAYER_EFFECT], 0, numLeds * sizeof(uint32_t));
+    memset(layerBuf[LAYER_OVERLAY], 0, numLeds * sizeof(uint32_t));
+    layers[LAYER_EFFECT].visible = false;
+    layers[LAYER_OVERLAY].visible = false;
+    layeringEnabled = true;
+  } else {
+    // Bake base + effect (never the overlay) into frame[], then draw there.
+    // While scrolling, frame[] must hold the unrotated base for the view.
+    layers[LAYER_OVERLAY].visible = false;
+    if (scrollView.active) memcpy(frame, layerBuf[LAYER_BASE], numLeds * sizeof(uint32_t));
+    else compositeLayers(0, numLeds - 1);
+    layeringEnabled = false;
+  }
+  layeringAuto = false;
+  endLayer();
+  markAllDirty();
+}
+
+// ======================
+// 🔔 OVERLAY NOTIFICATIONS
+// ======================
+void overlayNotify(uint32_t color, uint16_t ms) {
+  if (!layeringEnabled) {
+    setLayering(true);
+    layeringAuto = true;
+  }
+  uint32_t* ov = layerBuf[LAYER_OVERLAY];
+  memset(ov, 0, numLeds * sizeof(uint32_t));
+  for (uint16_t i = ledStart; i <= ledEnd && i < numLeds; i++) ov[i] = color;
+
+  overlayStart = millis();
+  overlayMs = ms ? ms : 1;
+  overlayFade = 255;
+  layers[LAYER_OVERLAY].visible = true;
+  markAllDirty();
+}
+
+// ======================
+// 🔄 LOOP UPDATER (before commitFrame)
+// ======================
+void updateLayers() {
+  if (!layeringEnabled) return;
+
+  // Effect layer is shown while an effect (main or zone) is set; cleared when it goes away
+  bool fx = (currentEffect != NONE || zoneEffectsRunning);
+  if (fx != layers[LAYER_EFFECT].visible) {
+    layers[LAYER_EFFECT].visible = fx;
+    if (!fx) memset(layerBuf[LAYER_EFFECT], 0, numLeds * sizeof(uint32_t));
+    markAllDirty();
+  }
+
+  // Overlay fades linearly to nothing over overlayMs
+  if (layers[LAYER_OVERLAY].visible) {
+    unsigned long t = millis() - overlayStart;
+    if (t >= overlayMs) {
+      layers[LAYER_OVERLAY].visible = false;
+      markAllDirty();
+      if (layeringAuto) setLayering(false);
+    } else {
+      uint8_t fade = 255 - (uint8_t)(t * 255 / overlayMs);
+      if (fade != overlayFade) {
+        overlayFade = fade;
+        markAllDirty();
+      }
+    }
+  }
+}
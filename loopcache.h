@@ -0,0 +1,124 @@
+#pragma once
+// =====================
+// 🔁 LOOP CACHE MODULE
+// =====================
+//
+// Frame cache for strictly periodic effects (RAINBOW, FADE_LOOP, WAVE,
+// CENTER_WAVE, HEARTBEAT; period declared in the effect table). Each tick
+// of the period is rendered live once and kept; from then on that tick is
+// a memcpy. Filling happens as the effect plays, so there is no bake pause.
+//
+// Effects that paint the whole range one color per tick (FADE_LOOP,
+// HEARTBEAT) keep a single color per tick instead of a frame.
+//
+// A cache belongs to one EffectState (main strip or zone) and is keyed by
+// everything its frames depend on: effect, range, speed, colors and the wave
+// base. Any change re-arms it. Storage comes from PSRAM when the board has
+// it (up to half of what is free), otherwise from the heap up to
+// LOOP_CACHE_HEAP_MAX; a loop that doesn't fit simply keeps rendering live.
+//
+// CMD:LOOPCACHE=ON | OFF | STATS
+//
+
+#define LOOP_CACHE_HEAP_MAX  (48 * 1024)   // bytes, boards without PSRAM
+#define LOOP_PERIOD_MAX      256           // ticks (size of the filled bitmap)
+
+struct LoopCache {
+  uint32_t key = 0;
+  uint16_t period = 0;       // 0 = nothing cached for this key
+  uint16_t len = 0;
+  bool solid = false;        // one color per tick instead of a frame
+  uint16_t pos = 0;          // tick about to be shown
+  uint32_t* data = nullptr;
+  size_t bytes = 0;
+  uint8_t filled[LOOP_PERIOD_MAX / 8] = {};
+};
+
+bool loopCacheEnabled = true;
+size_t loopCacheUsed = 0;    // bytes held by all caches
+uint32_t loopCacheHits = 0, loopCacheMisses = 0;
+
+inline uint32_t loopHash(uint32_t h, uint32_t v) {
+  return (h ^ v) * 16777619UL;   // FNV-1a step, one word at a time
+}
+
+size_t loopCacheBudget() {
+#if defined(BOARD_HAS_PSRAM)
+  if (psramFound()) return loopCacheUsed + ESP.getFreePsram() / 2;
+#endif
+  return LOOP_CACHE_HEAP_MAX;
+}
+
+void* loopCacheAlloc(size_t bytes) {
+#if defined(BOARD_HAS_PSRAM)
+  if (psramFound()) return ps_malloc(bytes);
+#endif
+  return malloc(bytes);
+}
+
+void loopCacheFree(LoopCache& c) {
+  if (c.data) {
+    free(c.data);
+    loopCacheUsed -= c.bytes;
+  }
+  c.data = nullptr;
+  c.bytes = 0;
+  c.key = 0;
+  c.period = 0;
+}
+
+// Start over for a new key at tick pos. Keeps the storage when the size
+// matches. Returns false (and remembers the key) if the loop doesn't fit.
+bool loopCacheArm(LoopCache& c, uint32_t key, uint16_t period, uint16_t len, bool solid, uint16_t pos) {
+  size_t need = (size_t)period * (solid ? 1 : len) * sizeof(uint32_t);
+  if (need != c.bytes) {
+    loopCacheFree(c);
+    if (loopCacheUsed + need <= loopCacheBudget()) c.data = (uint32_t*)loopCacheAlloc(need);
+    if (c.data) {
+      c.bytes = need;
+      loopCacheUsed += need;
+    }
+  }
+  c.key = key;
+  c.period = c.data ? period : 0;
+  c.len = len;
+  c.solid = solid;
+  c.pos = pos;
+  memset(c.filled, 0, sizeof(c.filled));
+  return c.data != nullptr;
+}
+
+inline bool loopCacheHas(const LoopCache& c, uint16_t pos) {
+  return c.filled[pos >> 3] & (1 << (pos & 7));
+}
+
+inline uint32_t* loopCacheSlot(const LoopCache& c, uint16_t pos) {
+  return c.data + (size_t)pos * (c.solid ? 1 : c.len);
+}
+
+// Tick pos → draw target from ledStart
+void loopCachePlay(const LoopCache& c, uint16_t pos, uint16_t from) {
+  const uint32_t* src = loopCacheSlot(c, pos);
+  if (c.solid) {
+    for (uint16_t i = 0; i < c.len; i++) setPixel(from + i, *src);
+  } else {
+    memcpy(drawRange(from, c.len), src, c.len * sizeof(uint32_t));
+  }
+  loopCacheHits++;
+}
+
+// Draw target from ledStart → tick pos
+void loopCacheStore(LoopCache& c, uint16_t pos, uint16_t from) {
+  uint32_t* dst = loopCacheSlot(c, pos);
+  if (c.solid) *dst = drawTarget[from];
+  else memcpy(dst, &drawTarget[from], c.len * sizeof(uint32_t));
+  c.filled[pos >> 3] |= (1 << (pos & 7));
+  loopCacheMisses++;
+}
+
+void loopCachePrintStats() {
+  Serial.print("🔁 Loop cache: "); Serial.print(loopCacheEnabled ? "ON" : "OFF");
+  Serial.print(" | "); Serial.print((uint32_t)loopCacheUsed); Serial.print("/");
+  Serial.print((uint32_t)loopCacheBudget()); Serial.print(" bytes | hits=");
+  Serial.print(loopCacheHits); Serial.print(" renders="); Serial.println(loopCacheMisses);
+}
@@ -0,0 +1,93 @@
+#pragma once
+// =====================
+// 🔲 MATRIX MODULE
+// =====================
+//
+// 2-D addressing for panels. With a matrix set, the first width × height
+// logical pixels of the range being rendered are a grid, row by row from
+// ledStart, either progressive (every row left → right) or serpentine
+// (odd rows wired right → left). XY(x, y) goes through a table built once
+// per layout, so effects never branch on the wiring.
+//
+// WAVE, CENTER_WAVE (radial rings), RAIN (drops falling down columns) and
+// FIREWORKS (radial bursts) switch to their 2-D shapes when the range holds
+// the whole grid; everything else, and ranges too short for the grid, stay
+// 1-D. All of it still renders into frame[], so zones, layers, crossfades
+// and the pixel map (pixelmap.h) work unchanged.
+//
+//   CMD:MATRIX=<w>,<h>[,SERP|PROG]   default SERP
+//   CMD:MATRIX=OFF | SHOW
+//
+
+#define MATRIX_MAX_SIDE 64
+
+bool matrixMode = false;
+uint8_t matrixW = 0, matrixH = 0;
+bool matrixSerpentine = true;
+uint16_t* matrixXY = nullptr;          // [y * matrixW + x] → offset from ledStart
+uint16_t* matrixColumn = nullptr;      // column-major cell → offset (falling particles)
+
+inline uint16_t matrixCells() { return (uint16_t)matrixW * matrixH; }
+
+// The range about to render holds the whole grid
+inline bool matrixActive() {
+  return matrixMode && (uint16_t)(ledEnd - ledStart + 1) >= matrixCells();
+}
+
+inline uint16_t XY(uint8_t x, uint8_t y) {
+  return matrixXY[(uint16_t)y * matrixW + x];
+}
+
+// Layout identity for caches keyed on what a frame looks like
+inline uint32_t matrixKey() {
+  return matrixMode ? ((uint32_t)matrixW << 16) | ((uint32_t)matrixH << 8) | matrixSerpentine : 0;
+}
+
+void matrixOff() {
+  free(matrixXY);
+  free(matrixColumn);
+  matrixXY = matrixColumn = nullptr;
+  matrixMode = false;
+  matrixW = matrixH = 0;
+}
+
+// Build the tables; false if the grid doesn't fit the strip or RAM
+bool matrixBegin(uint8_t w, uint8_t h, bool serpentine) {
+  if (!w || !h || w > MATRIX_MAX_SIDE || h > MATRIX_MAX_SIDE || (uint32_t)w * h > numLeds) return false;
+  matrixOff();
+  uint16_t n = (uint16_t)w * h;
+  matrixXY = (uint16_t*)malloc(n * sizeof(uint16_t));
+  matrixColumn = (uint16_t*)malloc(n * sizeof(uint16_t));
+  if (!matrixXY || !matrixColumn) {
+    matrixOff();
+    return false;
+  }
+  matrixW = w;
+  matrixH = h;
+  matrixSerpentine = serpentine;
+  for (uint8_t y = 0; y < h; y++) {
+    for (uint8_t x = 0; x < w; x++) {
+      uint16_t i = (uint16_t)y * w + ((serpentine && (y & 1)) ? w - 1 - x : x);
+      matrixXY[(uint16_t)y * w + x] = i;
+      matrixColumn[(uint16_t)x * h + y] = i;
+    }
+  }
+  matrixMode = true;
+  return true;
+}
+
+// Distance of (x, y) from the grid center, in cells
+inline float matrixRadius(uint8_t x, uint8_t y) {
+  float dx = x - (matrixW - 1) * 0.5f;
+  float dy = y - (matrixH - 1) * 0.5f;
+  return sqrtf(dx * dx + dy * dy);
+}
+
+void matrixPrint() {
+  if (!matrixMode) {
+    Serial.println("🔲 Matrix: OFF");
+    return;
+  }
+  Serial.print("🔲 Matrix: "); Serial.print(matrixW); Serial.print("x"); Serial.print(matrixH);
+  Serial.println(matrixSerpentine ? " serpentine" : " progressive");
+}
@@ -40,8 +40,7 @@ void applyMood(MoodType mood, String subMood = "") {
   currentEffect = NONE;
   multiColorCount = 0;
   effectSpeed = 100;
-  brightness = 100;
-  strip.setBrightness(brightness);
+  setEffectLevel(255);   // moods dim through effects, never through brightnessPct
 
   // 🔥 MAIN MOOD SYSTEM
   if (mood == MOOD_HAPPY) {
@@ -166,7 +165,6 @@ void applyMood(MoodType mood, String subMood = "") {
     currentEffect = NONE;
   }
 
-  strip.setBrightness(brightness);
   runCurrentEffect();
 
   // ✅ Final log
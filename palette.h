@@ -0,0 +1,101 @@
+#pragma once
+#include "shared_state.h"
+
+// ======================
+// 🎨 PALETTE ENGINE MODULE
+// ======================
+//
+// Expands the multiColors stops into a 256-entry color table, so gradients
+// and palette-aware effects take a color with one index lookup per pixel
+// instead of per-LED float blending.
+//
+//   - any number of stops up to MAX_MULTI_COLORS
+//   - optional stop positions 0–255 (CMD:RGBN=r,g,b@pos;...)
+//   - interpolation in linear light, so midpoints don't go muddy/dark
+//   - wraps last → first, matching the gradient pattern
+//
+// Rebuilt only when the stops change (CMD:RGBN, CMD:COLORN, CMD:COLOR+=/-=).
+//
+
+struct Palette {
+    uint32_t lut[256];
+    uint8_t stopCount;
+    uint32_t hash;      // identifies the stops/positions this table was built from
+};
+
+Palette mainPalette;
+Palette* activePalette = &mainPalette;   // zones (zones.h) point this at their own
+
+// ======================
+// 🔧 BUILD
+// ======================
+inline float paletteToLinear(uint8_t v) { return powf(v / 255.0f, 2.2f); }
+inline uint8_t paletteFromLinear(float v) {
+    return (uint8_t)(powf(v, 1.0f / 2.2f) * 255.0f + 0.5f);
+}
+
+// FNV-1a over the stop data; cheap identity for caches
+uint32_t paletteHashStops(const uint8_t (*rgb)[3], const uint8_t* pos, uint8_t count) {
+    uint32_t h = 2166136261UL;
+    for (uint8_t i = 0; i < count; i++) {
+        for (uint8_t c = 0; c < 3; c++) { h ^= rgb[i][c]; h *= 16777619UL; }
+        h ^= pos ? pos[i] : 0xFF; h *= 16777619UL;
+    }
+    h ^= count; h *= 16777619UL;
+    return h;
+}
+
+// from zones.h
+void paletteRetireLut(const uint32_t* lut);
+
+// pos == nullptr → stops evenly spaced. Positions must be ascending.
+void paletteBuild(Palette& p, const uint8_t (*rgb)[3], const uint8_t* pos, uint8_t count) {
+    paletteRetireLut(p.lut);    // stored pictures keep the colors they were drawn in
+    p.stopCount = count;
+    p.hash = paletteHashStops(rgb, pos, count);
+
+    if (count == 0) { memset(p.lut, 0, sizeof(p.lut)); return; }
+    if (count == 1) {
+        uint32_t c = strip.Color(rgb[0][0], rgb[0][1], rgb[0][2]);
+        for (int i = 0; i < 256; i++) p.lut[i] = c;
+        return;
+    }
+
+    float lin[MAX_MULTI_COLORS][3];
+    uint16_t at[MAX_MULTI_COLORS];
+    for (uint8_t s = 0; s < count; s++) {
+        for (uint8_t c = 0; c < 3; c++) lin[s][c] = paletteToLinear(rgb[s][c]);
+        at[s] = pos ? pos[s] : (uint16_t)(s * 256 / count);
+    }
+
+    for (int i = 0; i < 256; i++) {
+        int x = (i < at[0]) ? i + 256 : i;    // before stop 0 → tail of the wrap segment
+        uint8_t seg = count - 1;
+        for (uint8_t s = 0; s + 1 < count; s++) {
+            if (x < at[s + 1]) { seg = s; break; }
+        }
+
+        // Segment seg runs from stop seg to stop seg+1 (last wraps to first)
+        uint8_t s2 = (seg + 1) % count;
+        int from = at[seg];
+        int to = (s2 == 0) ? at[0] + 256 : at[s2];
+        float t = (to > from) ? (float)(x - from) / (to - from) : 0.0f;
+
+        p.lut[i] = strip.Color(
+            paletteFromLinear(lin[seg][0] + (lin[s2][0] - lin[seg][0]) * t),
+            paletteFromLinear(lin[seg][1] + (lin[s2][1] - lin[seg][1]) * t),
+            paletteFromLinear(lin[seg][2] + (lin[s2][2] - lin[seg][2]) * t));
+    }
+}
+
+// Rebuild activePalette from multiColors (+ positions, if the last RGBN/COLORN gave them)
+void paletteFromMultiColors() {
+    paletteBuild(*activePalette, multiColors, multiStopPosSet ? multiStopPos : nullptr, multiColorCount);
+}
+
+// ======================
+// 🔍 LOOKUP
+// ======================
+// Palette effects only kick in when the user has set 2+ colors
+inline bool paletteActive() { return multiColorCount >= 2; }
+inline uint32_t paletteColor(uint8_t index) { return activePalette->lut[index]; }
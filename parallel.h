@@ -0,0 +1,200 @@
+#pragma once
+// =====================
+// ⚡ PARALLEL RENDER MODULE
+// =====================
+//
+// Splits one effect's render pass across cores for long strips. Effects
+// whose pixels depend only on (pixel, tick, state) are marked parallel in
+// the effect table (effects.h) and write their per-pixel work as a body
+// over [from, to). parallelFor() cuts the range into one slice per core:
+// the loop task renders slice 0, each worker one of the others, and the
+// call returns only when every slice is done, so frame[] is complete
+// before commitFrame() ever sees it. Anything sequential (loop cache,
+// symmetry copies) stays on the loop task around it. The loop task blocks
+// on a semaphore while the workers finish instead of spinning on its core.
+//
+// PAR_WORKERS helpers: one on dual-core ESP32s (pinned to core 0, the loop
+// runs on core 1), none elsewhere; host builds can pass -DPAR_WORKERS=n to
+// run n std::thread helpers. Ranges under parMinLeds render inline, where
+// the handoff would cost more than it saves. Off by default: measure with
+// `make -C test bench` (test_parallel) and turn it on where it pays.
+//
+//   CMD:PARALLEL=ON | OFF | STATS | <min leds>
+//
+
+#include <atomic>
+#include <type_traits>
+
+#ifndef PAR_WORKERS
+#if defined(ARDUINO_ARCH_ESP32) && !CONFIG_FREERTOS_UNICORE
+#define PAR_WORKERS 1
+#else
+#define PAR_WORKERS 0
+#endif
+#endif
+
+#define PAR_MIN_LEDS   600    // default: shorter ranges render inline
+#define PAR_TASK_STACK 4096
+#define PAR_TASK_PRIO  2      // above the UI task (tasks.h) sharing core 0
+#define PAR_TASK_CORE  0
+
+#if PAR_WORKERS && defined(ARDUINO_ARCH_ESP32)
+#include <freertos/semphr.h>
+#endif
+#if PAR_WORKERS && !defined(ARDUINO_ARCH_ESP32)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+bool parEnabled = false;
+uint16_t parMinLeds = PAR_MIN_LEDS;
+bool parStarted = false;
+
+// Telemetry
+uint32_t parSplitPasses = 0;   // passes rendered across cores
+uint32_t parInlinePasses = 0;  // parallel effects rendered inline (short range / off)
+
+typedef void (*ParBody)(void* ctx, uint16_t from, uint16_t to);
+
+struct ParJob {
+  ParBody body;
+  void* ctx;
+  uint16_t len;
+  uint8_t parts;
+};
+
+ParJob parJob;
+std::atomic<uint32_t> parGen{0};       // bumped once per job
+std::atomic<uint8_t> parPending{0};    // worker slices still running
+
+// Slice k of parts over len
+inline uint16_t parSliceStart(uint8_t k, uint8_t parts, uint16_t len) {
+  return (uint32_t)len * k / parts;
+}
+
+#if PAR_WORKERS
+#if defined(ARDUINO_ARCH_ESP32)
+TaskHandle_t parTask[PAR_WORKERS];
+SemaphoreHandle_t parDoneSem;          // given once per job, by the last slice to finish
+#else
+std::mutex parLock;
+std::condition_variable parWakeCv;
+#endif
+
+void parRunSlice(uint8_t k) {
+  const ParJob& j = parJob;
+  j.body(j.ctx, parSliceStart(k, j.parts, j.len), parSliceStart(k + 1, j.parts, j.len));
+  bool last = parPending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+#if defined(ARDUINO_ARCH_ESP32)
+  if (last) xSemaphoreGive(parDoneSem);
+#else
+  (void)last;
+#endif
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+void parWorkerMain(void* arg) {
+  uint8_t k = (uint8_t)(uintptr_t)arg;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    parGen.load(std::memory_order_acquire);   // pairs with parWake(): parJob is visible
+    parRunSlice(k);
+  }
+}
+#else
+void parWorkerMain(uint8_t k) {
+  uint32_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lk(parLock);
+      parWakeCv.wait(lk, [&] { return parGen.load(std::memory_order_acquire) != seen; });
+      seen = parGen.load(std::memory_order_relaxed);
+    }
+    parRunSlice(k);
+  }
+}
+#endif
+
+void parWake() {
+#if defined(ARDUINO_ARCH_ESP32)
+  parGen.fetch_add(1, std::memory_order_release);
+  for (uint8_t w = 0; w < PAR_WORKERS; w++) xTaskNotifyGive(parTask[w]);
+#else
+  {
+    std::lock_guard<std::mutex> g(parLock);
+    parGen.fetch_add(1, std::memory_order_release);
+  }
+  parWakeCv.notify_all();
+#endif
+}
+
+// Barrier: every worker slice written. The ESP32 loop task sleeps until
+// the last worker gives the semaphore (its task notification belongs to
+// idle.h); host threads yield.
+void parWait() {
+#if defined(ARDUINO_ARCH_ESP32)
+  xSemaphoreTake(parDoneSem, portMAX_DELAY);
+  parPending.load(std::memory_order_acquire);   // pairs with the workers' fetch_sub
+#else
+  while (parPending.load(std::memory_order_acquire)) std::this_thread::yield();
+#endif
+}
+#endif
+
+// End of setup()
+void parallelBegin() {
+#if PAR_WORKERS
+#if defined(ARDUINO_ARCH_ESP32)
+  parDoneSem = xSemaphoreCreateBinary();
+  if (!parDoneSem) return;   // no workers: everything renders inline
+#endif
+  for (uint8_t w = 0; w < PAR_WORKERS; w++) {
+#if defined(ARDUINO_ARCH_ESP32)
+    xTaskCreatePinnedToCore(parWorkerMain, "billu-par", PAR_TASK_STACK, (void*)(uintptr_t)(w + 1),
+                            PAR_TASK_PRIO, &parTask[w], PAR_TASK_CORE);
+#else
+    std::thread(parWorkerMain, (uint8_t)(w + 1)).detach();
+#endif
+  }
+  parStarted = true;
+#endif
+}
+
+// Slices for a pass over len (1 = render inline)
+inline uint8_t parParts(uint16_t len) {
+  if (!PAR_WORKERS || !parStarted || !parEnabled || len < parMinLeds) return 1;
+  return PAR_WORKERS + 1;
+}
+
+// body(from, to) over [0, len), split across the cores; returns when all
+// slices are done. body must only touch its own slice of any output.
+template <typename F>
+void parallelFor(uint16_t len, F&& body) {
+  uint8_t parts = parParts(len);
+  if (parts <= 1) {
+    parInlinePasses++;
+    body(0, len);
+    return;
+  }
+#if PAR_WORKERS
+  typedef typename std::remove_reference<F>::type Body;
+  parJob.body = [](void* ctx, uint16_t from, uint16_t to) { (*(Body*)ctx)(from, to); };
+  parJob.ctx = (void*)&body;
+  parJob.len = len;
+  parJob.parts = parts;
+  parPending.store(parts - 1, std::memory_order_relaxed);
+  parWake();
+  body(0, parSliceStart(1, parts, len));
+  parWait();
+  parSplitPasses++;
+#endif
+}
+
+void parallelPrint() {
+  Serial.print("⚡ Parallel render: "); Serial.print(parEnabled ? "ON" : "OFF");
+  Serial.print(" | cores "); Serial.print(PAR_WORKERS + 1);
+  Serial.print(" | min "); Serial.print(parMinLeds); Serial.println(" LEDs");
+  Serial.print("   split passes="); Serial.print(parSplitPasses);
+  Serial.print(" inline="); Serial.println(parInlinePasses);
+}
@@ -0,0 +1,200 @@
+#pragma once
+// =====================
+// ✨ PARTICLE ENGINE MODULE
+// =====================
+//
+// Fixed-capacity particle pool shared by FIREWORKS, RAIN, DRIZZLE,
+// STAR_RAIN and COLOR_COMET. Storage is structure-of-arrays and live
+// particles stay packed in [0, particleCount), so update and render cost
+// scales with the number of live particles, not with the strip length.
+//
+// Positions are 8.8 fixed point relative to the range start. Each frame an
+// effect spawns, then calls particlesRender() (additive, saturating, into
+// frame[]) and particlesUpdate() (move, age, fade, recycle). Keyframed
+// renders (effects.h) pass keyStep so one update covers every tick they skip.
+//
+// Every particle is tagged with the render context that spawned it (0 = the
+// main strip, 1.. = zones.h). Reset, render and update only see the current
+// context's particles, so zones share the pool without disturbing each other.
+//
+
+#define MAX_PARTICLES 192
+
+// Particle flags
+#define PF_WRAP    0x01   // wrap around the range instead of dying at the edge
+#define PF_SPARKLE 0x02   // per-pixel color jitter (firework bursts)
+#define PF_PALETTE 0x04   // color each pixel from the palette by its position
+#define PF_COLUMN  0x08   // position is a column-major matrix cell (matrix.h)
+
+int32_t  pPos[MAX_PARTICLES];     // 8.8 fixed point, relative to range start
+int16_t  pVel[MAX_PARTICLES];     // 8.8 pixels per frame
+uint32_t pColor[MAX_PARTICLES];   // full-intensity color
+uint8_t  pLevel[MAX_PARTICLES];   // current intensity (255 = full color)
+uint8_t  pDecay[MAX_PARTICLES];   // intensity lost per frame
+uint8_t  pAge[MAX_PARTICLES];     // frames alive
+uint8_t  pLife[MAX_PARTICLES];    // max age in frames (0 = until faded out)
+uint8_t  pSpread[MAX_PARTICLES];  // glow half-width around the head
+uint8_t  pTail[MAX_PARTICLES];    // trail length behind a moving head
+uint8_t  pFlags[MAX_PARTICLES];
+uint8_t  pOwner[MAX_PARTICLES];   // render context that spawned it
+uint16_t particleCount = 0;
+uint8_t  particleContext = 0;     // context spawning/drawing right now
+
+// Spawn rate control: rate is particles per frame in 8.8 fixed point
+struct ParticleEmitter {
+  uint16_t rate;
+  uint16_t acc;
+};
+
+inline uint8_t emitterTick(ParticleEmitter& e) {
+  e.acc += e.rate;
+  uint8_t n = e.acc >> 8;
+  e.acc &= 0xFF;
+  return n;
+}
+
+// Forward: swap-remove (below)
+inline void particleKill(uint16_t i);
+
+// Drop the current context's particles
+void particlesReset() {
+  uint16_t p = 0;
+  while (p < particleCount) {
+    if (pOwner[p] == particleContext) particleKill(p);
+    else p++;
+  }
+}
+
+// Live particles owned by the current context
+uint16_t particlesLive() {
+  uint16_t n = 0;
+  for (uint16_t p = 0; p < particleCount; p++) n += (pOwner[p] == particleContext);
+  return n;
+}
+
+// Returns the slot used. When the pool is full (or at the governor's cap,
+// governor.h) the dimmest particle is recycled, preferring one of the
+// current context's own.
+uint16_t particleSpawn(int pos, uint32_t color, uint8_t decay,
+                       int16_t vel = 0, uint8_t spread = 0, uint8_t tail = 0,
+                       uint8_t life = 0, uint8_t flags = 0) {
+  uint16_t i = particleCount;
+  if (i >= gov().particleCap) {
+    i = 0;
+    bool own = (pOwner[0] == particleContext);
+    for (uint16_t k = 1; k < particleCount; k++) {
+      bool kOwn = (pOwner[k] == particleContext);
+      if ((kOwn && !own) || (kOwn == own && pLevel[k] < pLevel[i])) { i = k; own = kOwn; }
+    }
+  } else {
+    particleCount++;
+  }
+
+  pPos[i] = (int32_t)pos << 8;
+  pVel[i] = vel;
+  pColor[i] = color;
+  pLevel[i] = 255;
+  pDecay[i] = decay;
+  pAge[i] = 0;
+  pLife[i] = life;
+  pSpread[i] = spread;
+  pTail[i] = tail;
+  pFlags[i] = flags;
+  pOwner[i] = particleContext;
+  return i;
+}
+
+// Swap-remove keeps the live set packed
+inline void particleKill(uint16_t i) {
+  uint16_t last = --particleCount;
+  if (i == last) return;
+  pPos[i] = pPos[last];
+  pVel[i] = pVel[last];
+  pColor[i] = pColor[last];
+  pLevel[i] = pLevel[last];
+  pDecay[i] = pDecay[last];
+  pAge[i] = pAge[last];
+  pLife[i] = pLife[last];
+  pSpread[i] = pSpread[last];
+  pTail[i] = pTail[last];
+  pFlags[i] = pFlags[last];
+  pOwner[i] = pOwner[last];
+}
+
+// ======================
+// 🖌 RENDER
+// ======================
+inline void plotParticle(uint16_t p, int x, uint8_t level, uint16_t start, uint16_t len) {
+  if (x < 0 || x >= (int)len) {
+    if (!(pFlags[p] & PF_WRAP)) return;
+    x %= (int)len;
+    if (x < 0) x += len;
+  }
+
+  uint32_t c = (pFlags[p] & PF_PALETTE) ? paletteColor((uint32_t)x * 256 / len) : pColor[p];
+  if (pFlags[p] & PF_SPARKLE) {
+    uint32_t rnd = rngNext();
+    int r = (int)((c >> 16) & 0xFF) + rngByteRange(rnd, 0, 80) - 40;
+    int g = (int)((c >> 8) & 0xFF) + rngByteRange(rnd >> 8, 0, 80) - 40;
+    int b = (int)(c & 0xFF) + rngByteRange(rnd >> 16, 0, 80) - 40;
+    c = strip.Color(constrain(r, 0, 255), constrain(g, 0, 255), constrain(b, 0, 255));
+  }
+  if (pFlags[p] & PF_COLUMN) {
+    if (x >= (int)matrixCells()) return;
+    x = matrixColumn[x];
+  }
+  addPixel(start + x, scaleColor(c, level));
+}
+
+void particlesRender(uint16_t start, uint16_t len) {
+  if (len == 0) return;
+  for (uint16_t p = 0; p < particleCount; p++) {
+    if (pOwner[p] != particleContext) continue;
+    int head = pPos[p] >> 8;
+    uint8_t level = pLevel[p];
+
+    // Glow: linear falloff across the spread
+    uint8_t s = pSpread[p];
+    for (int d = -s; d <= s; d++) {
+      uint8_t l = s ? (uint8_t)(level * (s + 1 - abs(d)) / (s + 1)) : level;
+      plotParticle(p, head + d, l, start, len);
+    }
+
+    // Tail: linear fade behind the direction of travel
+    uint8_t t = pTail[p];
+    int dir = (pVel[p] >= 0) ? -1 : 1;
+    for (int k = 1; k < t; k++) {
+      int x = head + dir * k;
+      if ((pFlags[p] & PF_COLUMN) && (x < 0 || x / matrixH != head / matrixH)) break;   // stay in the column
+      plotParticle(p, x, (uint8_t)(level * (t - k) / t), start, len);
+    }
+  }
+}
+
+// ======================
+// ⏱ UPDATE
+// ======================
+void particlesUpdate(uint16_t len, uint8_t steps = 1) {
+  int32_t span = (int32_t)len << 8;
+  uint16_t p = 0;
+  while (p < particleCount) {
+    if (pOwner[p] != particleContext) { p++; continue; }
+    pPos[p] += (int32_t)pVel[p] * steps;
+    if (pFlags[p] & PF_WRAP) {
+      pPos[p] %= span;
+      if (pPos[p] < 0) pPos[p] += span;
+    }
+    pAge[p] = (pAge[p] + steps > 255) ? 255 : pAge[p] + steps;
+
+    uint16_t fade = (uint16_t)pDecay[p] * steps;
+    bool dead = (fade && pLevel[p] <= fade) ||
+                (pLife[p] && pAge[p] >= pLife[p]) ||
+                (!(pFlags[p] & PF_WRAP) && (pPos[p] < 0 || pPos[p] >= span));
+    if (dead) {
+      particleKill(p);       // slot p now holds a not-yet-updated particle
+      continue;
+    }
+    pLevel[p] -= fade;
+    p++;
+  }
+}
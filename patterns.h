@@ -10,37 +10,72 @@
 //   - scroll animation (wrap-around shift of the static frame)
 //   - CMD:PATTERN=stop to halt animation
 //
+// Scrolling is a view, not a redraw: the static frame stays where it was
+// drawn and commitFrame() reads it through a rotating 8.8 offset
+// (scrollView in render.h). A step only moves the offset, so any speed,
+// fractional steps for smooth slow scrolls, reverse and ping-pong are free.
+// CMD:SCROLL=<pixels per step>[,<ms per step>] | PINGPONG | WRAP.
+//
 
 // 🎛 PATTERN STATE
 String basePattern = "";            // current static pattern (stripe/split/gradient)
 bool scrollMode = false;
 unsigned long lastPatternUpdate = 0;
 int patternSpeed = 100;             // ms between shifts
+int16_t scrollStep = 256;           // 8.8 pixels per shift; negative scrolls backwards
+bool scrollPingPong = false;        // bounce instead of wrapping
 
 // --- Scroll engine state ---
-uint32_t scrollBase[600];           // raise if you use >600 LEDs
+uint8_t* scrollBaseIdx;             // numLeds, from the strip arena (1 byte each, indexed.h)
+IndexedBase scrollBaseStore = {};
+IndexedBase* scrollBase = &scrollBaseStore;   // zones (zones.h) capture into their own slice
 int scrollBaseLen = 0;
 bool scrollBaseCaptured = false;
-int scrollOffset = 0;
+
+// Show the base range through the view (keeps the offset if already running)
+void scrollViewStart() {
+    uint16_t len = ledEnd - ledStart + 1;
+    if (!scrollView.active || scrollView.from != ledStart || scrollView.len != len) scrollView.pos = 0;
+    scrollView.from = ledStart;
+    scrollView.len = len;
+    scrollView.active = true;
+    markDirty(ledStart, ledEnd);
+}
+
+// Leave the picture where the scroll had it: write the rotated range back
+void scrollViewBake() {
+    if (!scrollView.active) return;
+    scrollView.active = false;
+    uint16_t len = scrollView.len;
+    if (scrollView.from + len > numLeds) return;
+    if (!indexedStore(*scrollBase, &baseBuffer()[scrollView.from], len, activePalette->lut)) {
+        Serial.println("⚠️ Scroll: no RAM for an exact copy, picture left unscrolled");
+        markDirty(scrollView.from, scrollView.from + len - 1);
+        return;
+    }
+    for (uint16_t r = 0; r < len; r++) setPixel(scrollView.from + r, scrollViewSample(*scrollBase, r));
+    markDirty(scrollView.from, scrollView.from + len - 1);
+}
 
 inline void stopScrollMode() {
+    scrollViewBake();
     scrollMode = false;
     scrollBaseCaptured = false;
-    scrollOffset = 0;
 }
 
-// Capture the current static frame into scrollBase
+const IndexedBase* baseCacheLookup();   // below, with the base frame cache
+
+// Capture the current static frame into scrollBase: from the base frame
+// cache when it matches, else straight from the base buffer
 void captureScrollBase() {
     int totalLEDs = ledEnd - ledStart + 1;
     if (totalLEDs <= 0) return;
-    if (totalLEDs > (int)(sizeof(scrollBase)/sizeof(scrollBase[0])))
-        totalLEDs = sizeof(scrollBase)/sizeof(scrollBase[0]);
 
-    for (int i = 0; i < totalLEDs; i++) {
-        scrollBase[i] = strip.getPixelColor(ledStart + i);
-    }
+    const IndexedBase* cached = baseCacheLookup();
+    if (cached) indexedCopy(*scrollBase, *cached, totalLEDs);
+    else if (!indexedStore(*scrollBase, &baseBuffer()[ledStart], totalLEDs, activePalette->lut))
+        Serial.println("⚠️ Wave base approximated: no RAM for an exact copy");
     scrollBaseLen = totalLEDs;
-    scrollOffset = 0;
     scrollBaseCaptured = true;
 }
 
@@ -53,7 +88,7 @@ void patternStripe() {
 
     int colorIndex = 0;
     for (int i = ledStart; i <= ledEnd; i++) {
-        strip.setPixelColor(i, strip.Color(
+        setPixel(i, strip.Color(
             multiColors[colorIndex][0],
             multiColors[colorIndex][1],
             multiColors[colorIndex][2]
@@ -61,11 +96,11 @@ void patternStripe() {
         colorIndex++;
         if (colorIndex >= multiColorCount) colorIndex = 0;
     }
-    strip.show();
     scrollBaseCaptured = false;
 }
 
 // ✅ GRADIENT Pattern (with last→first wraparound)
+// One palette lookup per LED; the blend itself lives in palette.h
 void patternGradient() {
     if (multiColorCount < 2) {
         Serial.println("⚠️ Gradient needs at least 2 colors");
@@ -75,48 +110,10 @@ void patternGradient() {
     int totalLEDs = ledEnd - ledStart + 1;
     if (totalLEDs <= 0) return;
 
-    // segments == number of color transitions (include wraparound)
-    int segments = multiColorCount;                // note: NOT -1 anymore
-    int basePerSeg = totalLEDs / segments;
-    int extra = totalLEDs % segments;
-
-    int ledIndex = ledStart;
-
-    for (int c = 0; c < segments; c++) {
-        // from color c to next color (wrap last→0)
-        int c2 = (c + 1) % multiColorCount;
-
-        uint8_t r1 = multiColors[c][0];
-        uint8_t g1 = multiColors[c][1];
-        uint8_t b1 = multiColors[c][2];
-
-        uint8_t r2 = multiColors[c2][0];
-        uint8_t g2 = multiColors[c2][1];
-        uint8_t b2 = multiColors[c2][2];
-
-        // fair distribution across all segments
-        int segCount = basePerSeg + (c < extra ? 1 : 0);
-        if (segCount <= 0) continue;
-
-        for (int i = 0; i < segCount && ledIndex <= ledEnd; i++) {
-            float t = (segCount == 1) ? 1.0f : (float)i / (segCount - 1);
-            uint8_t r = (uint8_t)(r1 * (1 - t) + r2 * t);
-            uint8_t g = (uint8_t)(g1 * (1 - t) + g2 * t);
-            uint8_t b = (uint8_t)(b1 * (1 - t) + b2 * t);
-            strip.setPixelColor(ledIndex++, strip.Color(r, g, b));
-        }
-    }
-
-    // safety clamp
-    while (ledIndex <= ledEnd) {
-        strip.setPixelColor(ledIndex++, strip.Color(
-            multiColors[multiColorCount - 1][0],
-            multiColors[multiColorCount - 1][1],
-            multiColors[multiColorCount - 1][2]
-        ));
+    for (int i = 0; i < totalLEDs; i++) {
+        setPixel(ledStart + i, paletteColor((uint32_t)i * 256 / totalLEDs));
     }
 
-    strip.show();
     // New static image ready; invalidate old capture
     scrollBaseCaptured = false;
 }
@@ -133,29 +130,115 @@ void patternSplit() {
     for (int c = 0; c < multiColorCount; c++) {
         int count = sectionSize + (c < extraLEDs ? 1 : 0);
         for (int i = 0; i < count; i++) {
-            strip.setPixelColor(ledIndex,
+            setPixel(ledIndex,
                 strip.Color(multiColors[c][0], multiColors[c][1], multiColors[c][2]));
             ledIndex++;
         }
     }
-    strip.show();
     scrollBaseCaptured = false;
 }
 
 // ======================
-// 🔁 SCROLL ANIMATION
+// 🗃 BASE FRAME CACHE
 // ======================
-void animateScroll() {
-    if (!scrollBaseCaptured || scrollBaseLen <= 1) return;
+// redrawBase() is the one way commands repaint the static picture. It keeps
+// the last picture it rendered together with everything it was rendered
+// from; asking for the same pattern, palette and range again is a table
+// expand. Stored indexed (indexed.h), relative to the range start.
+// WAVE-style effects take their modulation base from here too.
+enum BasePatternId : uint8_t { BASE_FILL, BASE_BLOCKS, BASE_STRIPE, BASE_GRADIENT, BASE_SPLIT };
+
+struct BaseCacheKey {
+    uint32_t paletteHash;
+    uint32_t color, composite1, composite2;
+    uint16_t from, to;
+    uint8_t pattern;
+    uint8_t colorCount;
+    bool composite;
+};
+
+IndexedBase baseCache = {};   // valid over [baseCacheKey.from..to]; idx from the strip arena
+BaseCacheKey baseCacheKey;
+bool baseCacheValid = false;
+
+BaseCacheKey baseCacheKeyNow() {
+    BaseCacheKey k;
+    memset(&k, 0, sizeof(k));      // padding takes part in the memcmp
+    k.from = ledStart;
+    k.to = (ledEnd < numLeds) ? ledEnd : numLeds - 1;
+    k.colorCount = multiColorCount;
+    if (multiColorCount == 0) {
+        k.pattern = BASE_FILL;
+        k.composite = compositeMode;
+        k.color = currentColor;
+        k.composite1 = compositeColor1;
+        k.composite2 = compositeColor2;
+    } else {
+        k.pattern = (basePattern == "stripe") ? BASE_STRIPE
+                  : (basePattern == "gradient") ? BASE_GRADIENT
+                  : (basePattern == "split") ? BASE_SPLIT : BASE_BLOCKS;
+        k.paletteHash = activePalette->hash;
+    }
+    return k;
+}
+
+// Cached picture for the current state (from ledStart), or nullptr
+const IndexedBase* baseCacheLookup() {
+    if (!baseCacheValid) return nullptr;
+    BaseCacheKey k = baseCacheKeyNow();
+    return memcmp(&k, &baseCacheKey, sizeof(k)) == 0 ? &baseCache : nullptr;
+}
+
+void redrawBase() {
+    BaseCacheKey k = baseCacheKeyNow();
+    if (k.from > k.to) return;
+    uint16_t n = k.to - k.from + 1;
 
-    scrollOffset = (scrollOffset + 1) % scrollBaseLen;
+    if (baseCacheLookup()) {
+        indexedExpand(drawRange(k.from, n), baseCache, n);
+        return;
+    }
 
-    for (int i = 0; i < scrollBaseLen; i++) {
-        int src = i - scrollOffset;
-        if (src < 0) src += scrollBaseLen;
-        strip.setPixelColor(ledStart + i, scrollBase[src]);
+    switch (k.pattern) {
+        case BASE_STRIPE:   patternStripe(); break;
+        case BASE_GRADIENT: patternGradient(); break;
+        case BASE_SPLIT:    patternSplit(); break;
+        case BASE_BLOCKS:   renderMultiColorsBlock(); break;
+        default:            fillAll(currentColor); break;
     }
-    strip.show();
+
+    bool exact = indexedEncode(baseCache, &drawTarget[k.from], n, activePalette->lut);
+    baseCacheKey = k;
+    // A gradient with < 2 colors draws nothing, so there's nothing to cache
+    baseCacheValid = exact && !(k.pattern == BASE_GRADIENT && k.colorCount < 2);
+}
+
+// ======================
+// 🔁 SCROLL ANIMATION
+// ======================
+// One step: move the view offset and dirty the range; no pixels are written
+void animateScroll() {
+    if (!scrollView.active) return;
+    if (scrollView.from != ledStart || scrollView.len != ledEnd - ledStart + 1) {
+        markDirty(scrollView.from, scrollView.from + scrollView.len - 1);   // range changed under us
+        scrollViewStart();
+    }
+    if (scrollView.len <= 1) return;
+
+    int32_t span = (int32_t)scrollView.len << 8;
+    int32_t pos = (int32_t)scrollView.pos + scrollStep;
+    if (scrollPingPong) {
+        int32_t maxPos = span - 256;
+        if (pos < 0 || pos > maxPos) {
+            scrollStep = -scrollStep;
+            pos = constrain(pos, (int32_t)0, maxPos);
+        }
+    } else {
+        pos %= span;
+        if (pos < 0) pos += span;
+    }
+    scrollView.pos = pos;
+    markDirty(scrollView.from, scrollView.from + scrollView.len - 1);
 }
 
 // ======================
@@ -167,14 +250,11 @@ void handlePattern(String cmd) {
 
     if (pattern == "scroll") {
         scrollMode = true;
-        currentEffect = NONE;
+        if (!layeringEnabled) currentEffect = NONE;   // layered: effect keeps running on top
 
-        if (basePattern == "stripe")        patternStripe();
-        else if (basePattern == "gradient") patternGradient();
-        else if (basePattern == "split")    patternSplit();
-        else if (multiColorCount > 0)       renderMultiColorsBlock();
+        if (multiColorCount > 0) redrawBase();
 
-        captureScrollBase();
+        scrollViewStart();
         Serial.println("🔁 Scroll animation ENABLED");
         return;
     }
@@ -209,7 +289,7 @@ void updateActivePattern() {
     if (!scrollMode) return;
 
     unsigned long now = millis();
-    if (now - lastPatternUpdate < patternSpeed) return;
+    if (now - lastPatternUpdate < (unsigned long)patternSpeed) return;
     lastPatternUpdate = now;
 
     animateScroll();
@@ -217,17 +297,10 @@ void updateActivePattern() {
 
 // ✅ Trigger full pattern redraw + scroll re-capture
 void refreshCurrentPattern() {
-    if (multiColorCount == 0) {
-        fillAll(currentColor);
-        return;
-    }
-
-    if (basePattern == "stripe")        patternStripe();
-    else if (basePattern == "gradient") patternGradient();
-    else if (basePattern == "split")    patternSplit();
-    else                                renderMultiColorsBlock();
+    redrawBase();
+    if (multiColorCount == 0) return;
 
     if (scrollMode) {
-        captureScrollBase();
+        scrollViewStart();
     }
 }
@@ -0,0 +1,218 @@
+#pragma once
+// =====================
+// ⚙️ PIXEL KERNELS MODULE
+// =====================
+//
+// Whole-buffer operations on packed 0x00RRGGBB pixels:
+//
+//   pkScale(dst, src, n, level)        dst = src * (level+1)/256
+//   pkScaleEach(dst, src, levels, n)   same, one level per pixel (wave effects)
+//   pkLerp(dst, a, b, n, k)            dst = a + (b - a) * k/256, k = 0..256
+//   pkAddSat(dst, src, n)              dst = min(dst + src, 255) per channel
+//   pkFadeSub(buf, n, dr, dg, db)      buf = max(buf - d, 0) per channel
+//
+// Each kernel has three bodies with identical results:
+//   pkScalar*  reference: unpack r/g/b, one channel at a time
+//   pkSwar*    32-bit SWAR: R and B share one multiply, byte-lane add/sub
+//              with carry masks, no per-channel branches
+//   pkSse2*    host builds with SSE2: 4 pixels per 128-bit register
+//
+// The public pk* names pick one at compile time: SSE2 where the compiler
+// offers it (host builds), SWAR everywhere else, including all ESP32
+// targets. The Arduino core doesn't expose the ESP32-S3 PIE vector unit
+// through intrinsics, so S3 uses SWAR too. Define PK_FORCE_SCALAR to build
+// with the reference bodies, e.g. to compare output against them.
+//
+
+#if defined(PK_FORCE_SCALAR)
+  #define PK_PATH_SCALAR
+#elif defined(__SSE2__)
+  #define PK_PATH_SSE2
+  #include <emmintrin.h>
+#else
+  #define PK_PATH_SWAR
+#endif
+
+// ======================
+// 🐢 SCALAR REFERENCE
+// ======================
+inline uint32_t pkPack(uint32_t r, uint32_t g, uint32_t b) { return (r << 16) | (g << 8) | b; }
+
+void pkScalarScale(uint32_t* dst, const uint32_t* src, uint16_t n, uint8_t level) {
+  uint16_t k = (uint16_t)level + 1;
+  for (uint16_t i = 0; i < n; i++) {
+    uint32_t c = src[i];
+    dst[i] = pkPack((((c >> 16) & 0xFF) * k) >> 8, (((c >> 8) & 0xFF) * k) >> 8, ((c & 0xFF) * k) >> 8);
+  }
+}
+
+void pkScalarScaleEach(uint32_t* dst, const uint32_t* src, const uint8_t* levels, uint16_t n) {
+  for (uint16_t i = 0; i < n; i++) pkScalarScale(&dst[i], &src[i], 1, levels[i]);
+}
+
+void pkScalarLerp(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint16_t n, uint16_t k) {
+  uint16_t ik = 256 - k;
+  for (uint16_t i = 0; i < n; i++) {
+    uint32_t x = a[i], y = b[i];
+    dst[i] = pkPack((((x >> 16) & 0xFF) * ik + ((y >> 16) & 0xFF) * k) >> 8,
+                    (((x >> 8) & 0xFF) * ik + ((y >> 8) & 0xFF) * k) >> 8,
+                    ((x & 0xFF) * ik + (y & 0xFF) * k) >> 8);
+  }
+}
+
+void pkScalarAddSat(uint32_t* dst, const uint32_t* src, uint16_t n) {
+  for (uint16_t i = 0; i < n; i++) {
+    uint32_t x = dst[i], y = src[i];
+    uint16_t r = ((x >> 16) & 0xFF) + ((y >> 16) & 0xFF);
+    uint16_t g = ((x >> 8) & 0xFF) + ((y >> 8) & 0xFF);
+    uint16_t b = (x & 0xFF) + (y & 0xFF);
+    dst[i] = pkPack(r > 255 ? 255 : r, g > 255 ? 255 : g, b > 255 ? 255 : b);
+  }
+}
+
+void pkScalarFadeSub(uint32_t* buf, uint16_t n, uint8_t dr, uint8_t dg, uint8_t db) {
+  for (uint16_t i = 0; i < n; i++) {
+    uint32_t c = buf[i];
+    uint8_t r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
+    buf[i] = pkPack(r > dr ? r - dr : 0, g > dg ? g - dg : 0, b > db ? b - db : 0);
+  }
+}
+
+// ======================
+// 🧮 32-BIT SWAR
+// ======================
+// Single-pixel forms, also used by the per-pixel primitives in render.h
+inline uint32_t pkSwarScale1(uint32_t c, uint16_t k) {   // k = level + 1
+  return ((((c & 0xFF00FF) * k) >> 8) & 0xFF00FF) | ((((c & 0x00FF00) * k) >> 8) & 0x00FF00);
+}
+
+inline uint32_t pkSwarLerp1(uint32_t a, uint32_t b, uint16_t k) {
+  uint16_t ik = 256 - k;
+  return ((((a & 0xFF00FF) * ik + (b & 0xFF00FF) * k) >> 8) & 0xFF00FF) |
+         ((((a & 0x00FF00) * ik + (b & 0x00FF00) * k) >> 8) & 0x00FF00);
+}
+
+// Per-byte add without cross-lane carries, then force overflowed lanes to 0xFF
+inline uint32_t pkSwarAddSat1(uint32_t a, uint32_t b) {
+  uint32_t sum = ((a & 0x7F7F7F7F) + (b & 0x7F7F7F7F)) ^ ((a ^ b) & 0x80808080);
+  uint32_t carry = ((a & b) | ((a | b) & ~sum)) & 0x80808080;
+  return sum | ((carry >> 7) * 0xFF);
+}
+
+// Per-byte subtract without cross-lane borrows, then zero underflowed lanes
+inline uint32_t pkSwarSubSat1(uint32_t a, uint32_t d) {
+  uint32_t diff = ((a | 0x80808080) - (d & 0x7F7F7F7F)) ^ ((a ^ ~d) & 0x80808080);
+  uint32_t borrow = ((~a & d) | (~(a ^ d) & diff)) & 0x80808080;
+  return diff & ~((borrow >> 7) * 0xFF);
+}
+
+void pkSwarScale(uint32_t* dst, const uint32_t* src, uint16_t n, uint8_t level) {
+  uint16_t k = (uint16_t)level + 1;
+  for (uint16_t i = 0; i < n; i++) dst[i] = pkSwarScale1(src[i], k);
+}
+
+void pkSwarScaleEach(uint32_t* dst, const uint32_t* src, const uint8_t* levels, uint16_t n) {
+  for (uint16_t i = 0; i < n; i++) dst[i] = pkSwarScale1(src[i], (uint16_t)levels[i] + 1);
+}
+
+void pkSwarLerp(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint16_t n, uint16_t k) {
+  for (uint16_t i = 0; i < n; i++) dst[i] = pkSwarLerp1(a[i], b[i], k);
+}
+
+void pkSwarAddSat(uint32_t* dst, const uint32_t* src, uint16_t n) {
+  for (uint16_t i = 0; i < n; i++) dst[i] = pkSwarAddSat1(dst[i], src[i]);
+}
+
+void pkSwarFadeSub(uint32_t* buf, uint16_t n, uint8_t dr, uint8_t dg, uint8_t db) {
+  uint32_t d = pkPack(dr, dg, db);
+  for (uint16_t i = 0; i < n; i++) buf[i] = pkSwarSubSat1(buf[i], d);
+}
+
+// ======================
+// 🖥 SSE2 (host builds)
+// ======================
+#if defined(PK_PATH_SSE2)
+// 4 pixels → two registers of 8 × u16, scaled by per-lane factors, packed back
+inline __m128i pkSse2Mul(__m128i px, __m128i kLo, __m128i kHi) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), kLo), 8);
+  __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), kHi), 8);
+  return _mm_packus_epi16(lo, hi);
+}
+
+void pkSse2Scale(uint32_t* dst, const uint32_t* src, uint16_t n, uint8_t level) {
+  __m128i k = _mm_set1_epi16((int16_t)(level + 1));
+  uint16_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i px = _mm_loadu_si128((const __m128i*)&src[i]);
+    _mm_storeu_si128((__m128i*)&dst[i], pkSse2Mul(px, k, k));
+  }
+  pkSwarScale(&dst[i], &src[i], n - i, level);
+}
+
+void pkSse2ScaleEach(uint32_t* dst, const uint32_t* src, const uint8_t* levels, uint16_t n) {
+  uint16_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int16_t k0 = levels[i] + 1, k1 = levels[i + 1] + 1, k2 = levels[i + 2] + 1, k3 = levels[i + 3] + 1;
+    __m128i kLo = _mm_setr_epi16(k0, k0, k0, k0, k1, k1, k1, k1);
+    __m128i kHi = _mm_setr_epi16(k2, k2, k2, k2, k3, k3, k3, k3);
+    __m128i px = _mm_loadu_si128((const __m128i*)&src[i]);
+    _mm_storeu_si128((__m128i*)&dst[i], pkSse2Mul(px, kLo, kHi));
+  }
+  pkSwarScaleEach(&dst[i], &src[i], &levels[i], n - i);
+}
+
+void pkSse2Lerp(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint16_t n, uint16_t k) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i kb = _mm_set1_epi16((int16_t)k);
+  __m128i ka = _mm_set1_epi16((int16_t)(256 - k));
+  uint16_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128((const __m128i*)&a[i]);
+    __m128i y = _mm_loadu_si128((const __m128i*)&b[i]);
+    __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(x, zero), ka),
+                                              _mm_mullo_epi16(_mm_unpacklo_epi8(y, zero), kb)), 8);
+    __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(x, zero), ka),
+                                              _mm_mullo_epi16(_mm_unpackhi_epi8(y, zero), kb)), 8);
+    _mm_storeu_si128((__m128i*)&dst[i], _mm_packus_epi16(lo, hi));
+  }
+  pkSwarLerp(&dst[i], &a[i], &b[i], n - i, k);
+}
+
+void pkSse2AddSat(uint32_t* dst, const uint32_t* src, uint16_t n) {
+  uint16_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128((const __m128i*)&dst[i]);
+    __m128i y = _mm_loadu_si128((const __m128i*)&src[i]);
+    _mm_storeu_si128((__m128i*)&dst[i], _mm_adds_epu8(x, y));
+  }
+  pkSwarAddSat(&dst[i], &src[i], n - i);
+}
+
+void pkSse2FadeSub(uint32_t* buf, uint16_t n, uint8_t dr, uint8_t dg, uint8_t db) {
+  __m128i d = _mm_set1_epi32((int)pkPack(dr, dg, db));
+  uint16_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128((const __m128i*)&buf[i]);
+    _mm_storeu_si128((__m128i*)&buf[i], _mm_subs_epu8(x, d));
+  }
+  pkSwarFadeSub(&buf[i], n - i, dr, dg, db);
+}
+#endif
+
+// ======================
+// 🎯 COMPILE-TIME SELECTION
+// ======================
+#if defined(PK_PATH_SSE2)
+  #define PK_IMPL(name) pkSse2##name
+#elif defined(PK_PATH_SCALAR)
+  #define PK_IMPL(name) pkScalar##name
+#else
+  #define PK_IMPL(name) pkSwar##name
+#endif
+
+inline void pkScale(uint32_t* dst, const uint32_t* src, uint16_t n, uint8_t level) { PK_IMPL(Scale)(dst, src, n, level); }
+inline void pkScaleEach(uint32_t* dst, const uint32_t* src, const uint8_t* levels, uint16_t n) { PK_IMPL(ScaleEach)(dst, src, levels, n); }
+inline void pkLerp(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint16_t n, uint16_t k) { PK_IMPL(Lerp)(dst, a, b, n, k); }
+inline void pkAddSat(uint32_t* dst, const uint32_t* src, uint16_t n) { PK_IMPL(AddSat)(dst, src, n); }
+inline void pkFadeSub(uint32_t* buf, uint16_t n, uint8_t dr, uint8_t dg, uint8_t db) { PK_IMPL(FadeSub)(buf, n, dr, dg, db); }
@@ -0,0 +1,83 @@
+#pragma once
+// =====================
+// 🗺 PIXEL MAP MODULE
+// =====================
+//
+// Effects, zones and ledStart..ledEnd work on logical pixels
+// 0..numLeds-1. The map places them on the physical outputs: up to
+// PIXMAP_MAX_OUTPUTS strips on their own data pins (output 0 is `strip`),
+// each logical span landing on a run of one output, forwards or reversed.
+// Physical pixels no run covers are gaps and stay dark; a serpentine matrix
+// is one run per row with every other row reversed.
+//
+// The map is a list of run descriptors in logical order, fixed at boot
+// (stripconfig.h), so commitFrame() walks the dirty range run by run with a
+// linear physical index and pushes only the outputs it touched. A change
+// confined to one output no longer refreshes the whole install.
+//
+// Without a saved map, logical = physical on output 0 (the old layout).
+//
+//   CMD:MAP=ADD,<out>,<phys>,<len>[,R]        append a run (R = reversed)
+//   CMD:MAP=SERP,<out>,<width>,<rows>[,<phys>] append serpentine rows
+//   CMD:MAP=CLEAR | SHOW | SAVE               edit list; SAVE stores it
+//                                             and reboots to apply
+//
+
+#define PIXMAP_MAX_OUTPUTS 4
+#define PIXMAP_MAX_RUNS    64
+
+struct MapRun {
+  uint16_t from;       // first logical pixel
+  uint16_t len;
+  uint16_t phys;       // lowest physical pixel of the run
+  uint8_t out;
+  uint8_t reversed;    // logical `from` lands on phys + len - 1
+};
+
+Adafruit_NeoPixel outputExtra[PIXMAP_MAX_OUTPUTS - 1];
+Adafruit_NeoPixel* const outputs[PIXMAP_MAX_OUTPUTS] = { &strip, &outputExtra[0], &outputExtra[1], &outputExtra[2] };
+
+MapRun mapRuns[PIXMAP_MAX_RUNS];       // live map
+uint8_t mapRunCount = 0;
+MapRun mapEdit[PIXMAP_MAX_RUNS];       // CMD:MAP edit list
+uint8_t mapEditCount = 0;
+
+// Logical pixels covered by runs[0..count)
+uint32_t mapLength(const MapRun* runs, uint8_t count) {
+  return count ? (uint32_t)runs[count - 1].from + runs[count - 1].len : 0;
+}
+
+// Append a run after the last logical pixel; false when the list is full
+bool mapAppend(MapRun* runs, uint8_t& count, uint8_t out, uint16_t phys, uint16_t len, bool reversed) {
+  if (count >= PIXMAP_MAX_RUNS || !len) return false;
+  runs[count] = { (uint16_t)mapLength(runs, count), len, phys, out, reversed };
+  count++;
+  return true;
+}
+
+bool mapSerpentine(MapRun* runs, uint8_t& count, uint8_t out, uint16_t width, uint16_t rows, uint16_t phys) {
+  for (uint16_t r = 0; r < rows; r++) {
+    if (!mapAppend(runs, count, out, phys + r * width, width, r & 1)) return false;
+  }
+  return true;
+}
+
+// Every run inside its output (outLens[o] physical pixels, 0 = off) and
+// the logical length within maxLeds. Runs sharing an LED are allowed.
+bool mapValid(const MapRun* runs, uint8_t count, const uint16_t* outLens, uint16_t maxLeds) {
+  if (!count || mapLength(runs, count) > maxLeds) return false;
+  for (uint8_t k = 0; k < count; k++) {
+    const MapRun& r = runs[k];
+    if (r.out >= PIXMAP_MAX_OUTPUTS || (uint32_t)r.phys + r.len > outLens[r.out]) return false;
+  }
+  return true;
+}
+
+void mapPrint(const MapRun* runs, uint8_t count) {
+  for (uint8_t k = 0; k < count; k++) {
+    const MapRun& r = runs[k];
+    Serial.print("   "); Serial.print(r.from); Serial.print("-"); Serial.print(r.from + r.len - 1);
+    Serial.print(" → out "); Serial.print(r.out); Serial.print(" @ ");
+    Serial.print(r.phys); Serial.println(r.reversed ? " reversed" : "");
+  }
+}
@@ -0,0 +1,276 @@
+#pragma once
+// =====================
+// 🖼 RENDER PIPELINE MODULE
+// =====================
+//
+// Patterns and effects never touch the NeoPixel buffer. They draw into
+// frame[], a full-precision 0x00RRGGBB framebuffer owned by this module,
+// through setPixel()/getPixel()/clearPixels(). Writes widen a dirty range,
+// and loop() calls commitFrame() once at the very end: it copies the dirty
+// range into the strip through the output stage and pushes it, at most once
+// per frame and not at all when nothing changed. Because effects never read
+// back the brightness-scaled strip buffer, fading trails and wave modulation
+// no longer lose precision.
+//
+// The output stage is a set of 256-entry per-channel tables that fold global
+// brightness, effect-level dimming (PULSE, SOFT_GLOW), optional gamma and
+// white balance into one lookup. NeoPixel's own setBrightness() stays at
+// full scale, so nothing rescales the strip buffer in place. Zones (zones.h)
+// get their own brightness and effect dimming as output spans: per-range
+// levels applied on top of the tables at commit.
+//
+
+// --- Logical framebuffer (unscaled RGB) ---
+// numLeds pixels. This and every other per-LED buffer come from one arena
+// sized to the strip config at boot (stripconfig.h).
+uint32_t* frame;
+
+// Buffer the drawing primitives write to. Always frame[] unless the layer
+// compositor (layers.h) is on, in which case it points at the active layer.
+uint32_t* drawTarget;
+
+// from layers.h
+extern bool layeringEnabled;
+void compositeLayers(uint16_t from, uint16_t to);
+
+// --- Scroll view (driven by patterns.h) ---
+// The base picture over [from, from+len) is shown rotated by pos, in 8.8
+// fixed-point pixels. Scrolling moves pos; nothing is redrawn.
+struct ScrollView {
+  bool active;
+  uint16_t from, len;
+  uint32_t pos;
+};
+ScrollView scrollView = { false, 0, 0, 0 };
+
+// --- Keyframe interpolation (effects.h) ---
+// Ranges whose effect renders below the display rate. There the output is
+// lerp(keyPrev, frame, k): previous keyframe → current one. Contexts
+// re-register every loop; beginFrame() clears the list.
+#define MAX_KEY_SPANS 8
+struct KeySpan {
+  uint16_t from, to;
+  uint16_t k;            // 0..256
+};
+KeySpan keySpans[MAX_KEY_SPANS];
+uint8_t keySpanCount = 0;
+uint32_t* keyPrev;     // numLeds
+
+inline void addKeySpan(uint16_t from, uint16_t to, uint16_t k) {
+  if (keySpanCount < MAX_KEY_SPANS) keySpans[keySpanCount++] = { from, to, k };
+}
+
+inline void beginFrame() {
+  keySpanCount = 0;
+}
+
+// from transition.h
+void transitionStep();
+uint32_t transitionPixel(uint16_t i);
+
+// --- Dirty tracking ---
+bool frameDirty = false;
+uint16_t dirtyFrom = 0xFFFF;   // lowest changed pixel this frame
+uint16_t dirtyTo = 0;          // highest changed pixel this frame
+
+inline void markDirty(uint16_t from, uint16_t to) {
+  if (from < dirtyFrom) dirtyFrom = from;
+  if (to > dirtyTo) dirtyTo = to;
+  frameDirty = true;
+}
+
+inline void markAllDirty() {
+  markDirty(0, numLeds - 1);
+}
+
+// --- Output stage ---
+uint8_t effectLevel = 255;                 // effect dimming, on top of global brightness
+bool gammaEnabled = false;                 // RAINBOW/FADE_LOOP already gamma-correct themselves
+uint8_t whiteBalance[3] = {255, 255, 255}; // per-channel gain (R, G, B)
+uint8_t outLUT[3][256];
+bool outLUTStale = true;
+
+// Per-range dimming on top of the tables (filled by zones.h)
+#define MAX_OUTPUT_SPANS 8
+struct OutputSpan {
+  uint16_t from, to;
+  uint8_t level;
+};
+OutputSpan outputSpans[MAX_OUTPUT_SPANS];
+uint8_t outputSpanCount = 0;
+
+// While a zone renders, effect dimming goes to its span level instead of
+// the global tables
+uint8_t* effectLevelSink = nullptr;
+
+inline void invalidateOutputStage() { outLUTStale = true; }
+
+inline void setEffectLevel(uint8_t level) {
+  if (effectLevelSink) {
+    if (*effectLevelSink == level) return;
+    *effectLevelSink = level;
+    markDirty(ledStart, ledEnd);
+    return;
+  }
+  if (level == effectLevel) return;
+  effectLevel = level;
+  outLUTStale = true;
+}
+
+// Rebuild the per-channel tables from brightness, effectLevel, gamma and WB
+void rebuildOutputLUT() {
+  const uint32_t den = 255UL * 255UL * 255UL;
+  for (int v = 0; v < 256; v++) {
+    uint32_t x = gammaEnabled ? Adafruit_NeoPixel::gamma8(v) : v;
+    uint32_t scaled = x * brightness * effectLevel;   // ≤ 255³
+    for (int c = 0; c < 3; c++) {
+      outLUT[c][v] = (uint8_t)((scaled * whiteBalance[c] + den / 2) / den);
+    }
+  }
+  outLUTStale = false;
+}
+
+// ======================
+// ✏️ DRAWING PRIMITIVES
+// ======================
+inline void setPixel(uint16_t i, uint32_t c) {
+  if (i >= numLeds || drawTarget[i] == c) return;
+  drawTarget[i] = c;
+  markDirty(i, i);
+}
+
+inline void setPixel(uint16_t i, uint8_t r, uint8_t g, uint8_t b) {
+  setPixel(i, strip.Color(r, g, b));
+}
+
+inline uint32_t getPixel(uint16_t i) {
+  return (i < numLeds) ? drawTarget[i] : 0;
+}
+
+// Whole strip to black (same scope as strip.clear()), current layer only
+inline void clearPixels() {
+  memset(drawTarget, 0, numLeds * sizeof(uint32_t));
+  markAllDirty();
+}
+
+// Black out [from..to] only
+void clearRange(uint16_t from, uint16_t to) {
+  if (to >= numLeds) to = numLeds - 1;
+  if (from > to) return;
+  memset(&drawTarget[from], 0, (to - from + 1) * sizeof(uint32_t));
+  markDirty(from, to);
+}
+
+// Single-pixel forms of the kernels in pixelkernels.h
+// Scale a color by level/255 (level 255 = unchanged)
+inline uint32_t scaleColor(uint32_t c, uint8_t level) {
+  return pkSwarScale1(c, (uint16_t)level + 1);
+}
+
+// a + (b - a) * k/256 per channel (k = 0..256)
+inline uint32_t lerpColor(uint32_t a, uint32_t b, uint16_t k) {
+  return pkSwarLerp1(a, b, k);
+}
+
+// Additive blend with per-channel saturation
+inline void addPixel(uint16_t i, uint32_t c) {
+  if (i >= numLeds || !c) return;
+  setPixel(i, pkSwarAddSat1(drawTarget[i], c));
+}
+
+// Slice of the draw target for a whole-range kernel write; marks it dirty.
+// Caller keeps from + n within numLeds.
+inline uint32_t* drawRange(uint16_t from, uint16_t n) {
+  if (n) markDirty(from, from + n - 1);
+  return &drawTarget[from];
+}
+
+// Subtract a per-channel amount from every pixel in [from..to] (trail fade)
+void fadeRange(uint16_t from, uint16_t to, uint8_t dr, uint8_t dg, uint8_t db) {
+  if (to >= numLeds) to = numLeds - 1;
+  if (from > to) return;
+  pkFadeSub(drawRange(from, to - from + 1), to - from + 1, dr, dg, db);
+}
+
+// ======================
+// 🔁 SCROLL VIEW READS
+// ======================
+// Pixel r of the view, read from src (the range start) through the offset.
+// A fractional offset blends the two neighbouring source pixels. src is a
+// pixel pointer or an IndexedBase (indexed.h).
+template <typename Src>
+inline uint32_t scrollViewSample(const Src& src, uint16_t r) {
+  uint16_t len = scrollView.len;
+  int idx = (int)r - (int)(scrollView.pos >> 8);
+  if (idx < 0) idx += len;
+  uint8_t f = scrollView.pos & 0xFF;
+  if (!f) return src[idx];
+  return lerpColor(src[idx], src[idx ? idx - 1 : len - 1], f);
+}
+
+// Base-buffer pixel i as shown (through the scroll view when inside it)
+inline uint32_t viewPixel(const uint32_t* base, uint16_t i) {
+  if (!scrollView.active || i < scrollView.from || i - scrollView.from >= scrollView.len) return base[i];
+  return scrollViewSample(&base[scrollView.from], i - scrollView.from);
+}
+
+// Pixel i before the output stage. With layers on, the composite has
+// already read the base through the view.
+inline uint32_t logicalPixel(uint16_t i) {
+  uint32_t c = layeringEnabled ? frame[i] : viewPixel(frame, i);
+  for (uint8_t s = 0; s < keySpanCount; s++) {
+    if (i >= keySpans[s].from && i <= keySpans[s].to) return lerpColor(keyPrev[i], c, keySpans[s].k);
+  }
+  return c;
+}
+
+// ======================
+// 🚀 FRAME COMMIT
+// ======================
+// Logical pixel i through the output stage: tables, then its zone's level
+inline uint32_t outputPixel(uint16_t i) {
+  uint32_t c = transitionPixel(i);
+  for (uint8_t s = 0; s < outputSpanCount; s++) {
+    if (i >= outputSpans[s].from && i <= outputSpans[s].to) {
+      c = scaleColor(c, outputSpans[s].level);
+      break;   // zones come first and never overlap each other
+    }
+  }
+  return Adafruit_NeoPixel::Color(outLUT[0][(c >> 16) & 0xFF], outLUT[1][(c >> 8) & 0xFF], outLUT[2][c & 0xFF]);
+}
+
+// Single push point. Also used by the blocking lightning flashes in
+// effects.h, which need their intermediate frames on the LEDs before delay().
+// The dirty range goes out run by run through the pixel map (pixelmap.h);
+// only outputs it reached are shown.
+void commitFrame() {
+  if (outLUTStale) {
+    rebuildOutputLUT();
+    markAllDirty();     // every pixel changes when the tables do
+  }
+  transitionStep();
+  if (!frameDirty) return;
+  if (layeringEnabled) compositeLayers(dirtyFrom, dirtyTo);
+  uint8_t touched = 0;
+  for (uint8_t k = 0; k < mapRunCount; k++) {
+    const MapRun& r = mapRuns[k];
+    uint16_t last = r.from + r.len - 1;
+    if (r.from > dirtyTo || last < dirtyFrom) continue;
+    uint16_t from = (r.from > dirtyFrom) ? r.from : dirtyFrom;
+    uint16_t to = (last < dirtyTo) ? last : dirtyTo;
+    Adafruit_NeoPixel* out = outputs[r.out];
+    if (r.reversed) {
+      uint16_t p = r.phys + (last - from);
+      for (uint16_t i = from; i <= to; i++) out->setPixelColor(p--, outputPixel(i));
+    } else {
+      uint16_t p = r.phys + (from - r.from);
+      for (uint16_t i = from; i <= to; i++) out->setPixelColor(p++, outputPixel(i));
+    }
+    touched |= 1 << r.out;
+  }
+  for (uint8_t o = 0; o < PIXMAP_MAX_OUTPUTS; o++) if (touched & (1 << o)) outputs[o]->show();
+  govWork = true;
+  frameDirty = false;
+  dirtyFrom = 0xFFFF;
+  dirtyTo = 0;
+}
@@ -1,7 +1,12 @@
 #pragma once
 
-extern uint8_t multiColors[10][3];
+#define MAX_MULTI_COLORS 16
+
+extern uint8_t multiColors[MAX_MULTI_COLORS][3];
 extern int multiColorCount;
+extern uint8_t multiStopPos[MAX_MULTI_COLORS];   // optional palette stop positions (0–255)
+extern bool multiStopPosSet;
+void paletteFromMultiColors();
 
 void renderMultiColorsBlock();
 void refreshCurrentPattern();
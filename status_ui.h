@@ -3,6 +3,7 @@
 #pragma once
 #include "Billu_RoboEyes_EmoPack.h"
 #include "lcd_compat.h"
+#include "taskqueue.h"
 
 // ============ CONFIG ============
 #ifndef STATUS_USE_OVERLAY
@@ -28,6 +29,7 @@ inline String toAscii(const String& s){
 inline void statusShow(const String& s, uint16_t ms=STATUS_DEFAULT_MS){
   if (ms < STATUS_DEFAULT_MS) ms = STATUS_DEFAULT_MS;
   String msg = toAscii(s);  // keep ASCII safe
+  if (!onUiTask()) { uiPost(UI_STATUS, msg, ms); return; }   // render task: OLED is the UI task's
 #if STATUS_USE_OVERLAY
   Eyes_flash(msg, ms, STATUS_TEXT_SIZE); // pass desired size to overlay
 #else
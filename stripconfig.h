@@ -0,0 +1,247 @@
+#pragma once
+// =====================
+// 📏 STRIP CONFIG MODULE
+// =====================
+//
+// Strip length, data pin and pixel order of every output, and the pixel
+// map (pixelmap.h), are read from flash at boot (Preferences namespace
+// "strip"), so one firmware image drives any install. The logical length
+// numLeds is what the map covers. Every per-LED buffer (framebuffer, layers, crossfade and
+// keyframe copies, indexed bases, effect scratch) is carved out of one
+// arena allocated right after, sized to that length; nothing per-LED is
+// sized at compile time any more. The NeoPixel library allocates its own
+// 3-byte-per-LED output buffer for each output in updateLength().
+//
+// About 33 bytes per LED in total, so a few thousand LEDs fit in the heap.
+// If the arena can't be allocated the strip falls back to the defaults,
+// and if even that fails stripBegin() reports it and touches nothing.
+//
+//   CMD:STRIP=<leds>,<pin>,<order>   save (order: GRB, RGB, BRG, RBG,
+//                                    GBR, BGR) and reboot to apply
+//   CMD:OUTPUT=<n>,<leds>,<pin>,<order> | <n>,OFF   extra outputs 1..3,
+//                                    saved, applied on reboot
+//   CMD:STRIP=SHOW                   print the running config
+//
+
+#define STRIP_MAX_LEDS 4096
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <Preferences.h>
+#endif
+
+struct StripConfig {
+  uint16_t leds;         // 0 = output unused
+  uint8_t pin;
+  uint16_t order;        // NEO_GRB etc.
+};
+
+// Output 0 is `strip`; the others are the extra outputs of pixelmap.h
+StripConfig outputConfig[PIXMAP_MAX_OUTPUTS] = { { DEFAULT_NUM_LEDS, DEFAULT_LED_PIN, NEO_GRB } };
+
+struct PixelOrderName {
+  const char* name;
+  uint16_t order;
+};
+
+const PixelOrderName PIXEL_ORDERS[] = {
+  { "GRB", NEO_GRB }, { "RGB", NEO_RGB }, { "BRG", NEO_BRG },
+  { "RBG", NEO_RBG }, { "GBR", NEO_GBR }, { "BGR", NEO_BGR },
+};
+const uint8_t PIXEL_ORDER_COUNT = sizeof(PIXEL_ORDERS) / sizeof(PIXEL_ORDERS[0]);
+
+const char* pixelOrderName(uint16_t order) {
+  for (uint8_t i = 0; i < PIXEL_ORDER_COUNT; i++) if (PIXEL_ORDERS[i].order == order) return PIXEL_ORDERS[i].name;
+  return "?";
+}
+
+// Returns false for an unknown name
+bool pixelOrderParse(const String& name, uint16_t& order) {
+  for (uint8_t i = 0; i < PIXEL_ORDER_COUNT; i++) {
+    if (name == PIXEL_ORDERS[i].name) {
+      order = PIXEL_ORDERS[i].order;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool stripConfigValid(const StripConfig& c) {
+  return c.leds >= 1 && c.leds <= STRIP_MAX_LEDS && strcmp(pixelOrderName(c.order), "?") != 0;
+}
+
+void outputLengths(uint16_t* lens) {
+  for (uint8_t o = 0; o < PIXMAP_MAX_OUTPUTS; o++) lens[o] = outputConfig[o].leds;
+}
+
+// ======================
+// 💾 PERSISTENCE
+// ======================
+// Output 0 keeps its original keys; outputs 1.. are "out1".. blobs, the
+// pixel map is the "map" blob.
+void stripConfigLoad() {
+#if defined(ARDUINO_ARCH_ESP32)
+  Preferences prefs;
+  prefs.begin("strip", true);
+  StripConfig c;
+  c.leds = prefs.getUShort("leds", DEFAULT_NUM_LEDS);
+  c.pin = prefs.getUChar("pin", DEFAULT_LED_PIN);
+  c.order = prefs.getUShort("order", NEO_GRB);
+  if (stripConfigValid(c)) outputConfig[0] = c;
+  else Serial.println("⚠️ Saved strip config invalid, using defaults");
+  for (uint8_t o = 1; o < PIXMAP_MAX_OUTPUTS; o++) {
+    String key = "out" + String(o);
+    if (prefs.getBytes(key.c_str(), &c, sizeof(c)) == sizeof(c) && stripConfigValid(c)) outputConfig[o] = c;
+  }
+  size_t bytes = prefs.getBytes("map", mapRuns, sizeof(mapRuns));
+  mapRunCount = bytes / sizeof(MapRun);
+  prefs.end();
+#endif
+}
+
+// Output o; leds 0 switches an extra output off
+void stripConfigSave(uint8_t o, const StripConfig& c) {
+#if defined(ARDUINO_ARCH_ESP32)
+  Preferences prefs;
+  prefs.begin("strip", false);
+  if (o == 0) {
+    prefs.putUShort("leds", c.leds);
+    prefs.putUChar("pin", c.pin);
+    prefs.putUShort("order", c.order);
+  } else {
+    String key = "out" + String(o);
+    if (c.leds) prefs.putBytes(key.c_str(), &c, sizeof(c));
+    else prefs.remove(key.c_str());
+  }
+  prefs.end();
+#endif
+  outputConfig[o] = c;
+}
+
+// No runs = the identity map on output 0
+void pixelMapSave(const MapRun* runs, uint8_t count) {
+#if defined(ARDUINO_ARCH_ESP32)
+  Preferences prefs;
+  prefs.begin("strip", false);
+  if (count) prefs.putBytes("map", runs, count * sizeof(MapRun));
+  else prefs.remove("map");
+  prefs.end();
+#else
+  (void)runs; (void)count;
+#endif
+}
+
+// ======================
+// 🧱 BUFFER ARENA
+// ======================
+uint8_t* arena = nullptr;
+size_t arenaSize = 0;
+size_t arenaUsed = 0;
+
+// 4-byte aligned slice, zeroed with the arena
+template <typename T>
+T* arenaTake(uint16_t count) {
+  size_t bytes = ((size_t)count * sizeof(T) + 3) & ~(size_t)3;
+  T* p = (T*)(arena + arenaUsed);
+  arenaUsed += bytes;
+  return p;
+}
+
+// Bytes arenaAssign() takes for n LEDs
+size_t arenaBytesFor(uint16_t n) {
+  size_t words = (size_t)n * sizeof(uint32_t);
+  size_t bytes = ((size_t)n + 3) & ~(size_t)3;
+  return words * (3 + LAYER_COUNT) + bytes * 6;
+}
+
+void arenaAssign(uint16_t n) {
+  arenaUsed = 0;
+  frame = arenaTake<uint32_t>(n);
+  keyPrev = arenaTake<uint32_t>(n);
+  fadeFrom = arenaTake<uint32_t>(n);
+  for (uint8_t l = 0; l < LAYER_COUNT; l++) layerBuf[l] = arenaTake<uint32_t>(n);
+  scrollBaseIdx = arenaTake<uint8_t>(n);
+  baseCache.idx = arenaTake<uint8_t>(n);
+  zoneBaseStore = arenaTake<uint8_t>(n);
+  fireHeat = arenaTake<uint8_t>(n);
+  fireNoise = arenaTake<uint8_t>(n);
+  waveLevels = arenaTake<uint8_t>(n);
+
+  scrollBaseStore.idx = scrollBaseIdx;
+  drawTarget = frame;
+}
+
+void stripConfigPrint() {
+  for (uint8_t o = 0; o < PIXMAP_MAX_OUTPUTS; o++) {
+    const StripConfig& c = outputConfig[o];
+    if (!c.leds) continue;
+    Serial.print("📏 Output "); Serial.print(o); Serial.print(": "); Serial.print(c.leds);
+    Serial.print(" LEDs on pin "); Serial.print(c.pin); Serial.print(", "); Serial.println(pixelOrderName(c.order));
+  }
+  Serial.print("🗺 "); Serial.print(numLeds); Serial.print(" logical LEDs in ");
+  Serial.print(mapRunCount); Serial.print(" runs | arena ");
+  Serial.print((uint32_t)arenaSize); Serial.println(" bytes");
+}
+
+// ======================
+// 🚀 BOOT
+// ======================
+// Config → map → arena → outputs. Call first thing in setup(). Returns
+// false if there's no RAM for the buffers (numLeds and the outputs unchanged).
+bool stripBegin() {
+  stripConfigLoad();
+  uint16_t lens[PIXMAP_MAX_OUTPUTS];
+  outputLengths(lens);
+  if (mapRunCount && !mapValid(mapRuns, mapRunCount, lens, STRIP_MAX_LEDS)) {
+    Serial.println("⚠️ Saved pixel map doesn't fit the outputs, using the plain strip");
+    mapRunCount = 0;
+  }
+  memcpy(mapEdit, mapRuns, mapRunCount * sizeof(MapRun));
+  mapEditCount = mapRunCount;
+  if (!mapRunCount) mapAppend(mapRuns, mapRunCount, 0, 0, outputConfig[0].leds, false);
+
+  uint16_t n = mapLength(mapRuns, mapRunCount);
+  arenaSize = arenaBytesFor(n);
+  arena = (uint8_t*)calloc(1, arenaSize);
+  if (!arena && n != DEFAULT_NUM_LEDS) {
+    Serial.print("⚠️ No RAM for "); Serial.print(n); Serial.println(" LEDs, using defaults");
+    for (uint8_t o = 1; o < PIXMAP_MAX_OUTPUTS; o++) outputConfig[o].leds = 0;
+    outputConfig[0] = { DEFAULT_NUM_LEDS, DEFAULT_LED_PIN, NEO_GRB };
+    mapRunCount = 0;
+    mapAppend(mapRuns, mapRunCount, 0, 0, DEFAULT_NUM_LEDS, false);
+    n = DEFAULT_NUM_LEDS;
+    arenaSize = arenaBytesFor(n);
+    arena = (uint8_t*)calloc(1, arenaSize);
+  }
+  if (!arena) {
+    Serial.print("❌ No RAM for the LED buffers ("); Serial.print((uint32_t)arenaSize);
+    Serial.println(" bytes), LEDs disabled");
+    arenaSize = 0;
+    return false;
+  }
+  arenaAssign(n);
+
+  numLeds = n;
+  activeLEDCount = n;
+  ledStart = 0;
+  ledEnd = n - 1;
+
+  for (uint8_t o = 0; o < PIXMAP_MAX_OUTPUTS; o++) {
+    const StripConfig& c = outputConfig[o];
+    if (!c.leds) continue;
+    outputs[o]->updateType(c.order + NEO_KHZ800);
+    outputs[o]->updateLength(c.leds);
+    outputs[o]->setPin(c.pin);
+  }
+  stripConfigPrint();
+  return true;
+}
+
+// Output stage owns brightness, so every strip runs at full scale
+void outputsBegin() {
+  for (uint8_t o = 0; o < PIXMAP_MAX_OUTPUTS; o++) {
+    if (!outputConfig[o].leds) continue;
+    outputs[o]->begin();
+    outputs[o]->setBrightness(255);   // brightness is applied by the output stage (render.h)
+    outputs[o]->show();
+  }
+}
@@ -0,0 +1,80 @@
+#pragma once
+// =====================
+// 🪞 SYMMETRY MODULE
+// =====================
+//
+// Mirrored and repeated installs without per-effect code. With a symmetry
+// set, runCurrentEffect() narrows the range to its unique segment, the
+// effect renders only that, and symmetryExpand() fills the rest of the
+// range with block copies of it. Render cost (and loop-cache size) drops by
+// the number of copies, for every effect.
+//
+//   MIRROR       two copies, the second reversed (symmetric about the middle)
+//   KALEIDO,n    n copies, every other one reversed (default 4)
+//   TILE,n       n copies, all the same way
+//
+// Effects that modulate the static picture (the WAVE family) would lose
+// the picture if their pixels were copied, so they mirror their brightness
+// levels instead. 2-D panels (matrix.h) ignore symmetry.
+//
+//   CMD:SYMMETRY=OFF | MIRROR | KALEIDO[,n] | TILE,n
+//
+
+#define SYMMETRY_MAX_COPIES 16
+
+enum SymmetryMode { SYM_OFF, SYM_MIRROR, SYM_KALEIDO, SYM_TILE };
+
+SymmetryMode symMode = SYM_OFF;
+uint8_t symCopies = 1;
+
+inline bool symmetryOn() {
+  return symCopies > 1 && !matrixActive();
+}
+
+// First pixel of copy k over a range of len (copy 0 is the unique segment)
+inline uint16_t symStart(uint8_t k, uint16_t len) {
+  return ((uint32_t)k * len + symCopies - 1) / symCopies;
+}
+
+// Length of the unique segment, or len when symmetry is off
+inline uint16_t symmetryLen(uint16_t len) {
+  return symmetryOn() ? symStart(1, len) : len;
+}
+
+// buf[0..segment) → buf[0..len): forward copies memcpy, reversed ones
+// mirror so each fold is symmetric
+template <typename T>
+void symExpand(T* buf, uint16_t len) {
+  if (!symmetryOn()) return;
+  for (uint8_t k = 1; k < symCopies; k++) {
+    uint16_t from = symStart(k, len);
+    uint16_t n = symStart(k + 1, len) - from;
+    if (symMode == SYM_TILE || !(k & 1)) memcpy(&buf[from], buf, n * sizeof(T));
+    else for (uint16_t j = 0; j < n; j++) buf[from + j] = buf[n - 1 - j];
+  }
+}
+
+// Unique segment [ledStart, ledEnd] → the whole range up to fullEnd;
+// restores ledEnd
+void symmetryExpand(uint16_t fullEnd) {
+  ledEnd = fullEnd;
+  uint16_t len = fullEnd - ledStart + 1;
+  symExpand(drawRange(ledStart, len), len);
+}
+
+// Key for caches of what a frame looks like
+inline uint32_t symmetryKey() {
+  return symmetryOn() ? ((uint32_t)symMode << 8) | symCopies : 0;
+}
+
+void symmetrySet(SymmetryMode mode, uint8_t copies) {
+  symMode = mode;
+  symCopies = (mode == SYM_OFF) ? 1 : (mode == SYM_MIRROR) ? 2 : constrain(copies, 2, SYMMETRY_MAX_COPIES);
+}
+
+void symmetryPrint() {
+  const char* names[] = { "OFF", "MIRROR", "KALEIDO", "TILE" };
+  Serial.print("🪞 Symmetry: "); Serial.print(names[symMode]);
+  if (symMode == SYM_KALEIDO || symMode == SYM_TILE) { Serial.print(" x"); Serial.print(symCopies); }
+  Serial.println();
+}
@@ -0,0 +1,108 @@
+#pragma once
+// =====================
+// 🔀 TASK HANDOFF MODULE
+// =====================
+//
+// Lock-free single-producer/single-consumer rings between the two tasks of
+// the dual-core layout (tasks.h): command lines go UI → render, OLED
+// messages go render → UI. Each ring has exactly one writer of head and
+// one of tail, so acquire/release atomics are all the synchronisation
+// there is; neither side ever blocks the other.
+//
+// statusShow() and lcdMessage() called on the render task (from inside
+// processCommand()) post here instead of touching the display.
+//
+// DUAL_CORE defaults to on for dual-core ESP32s and off elsewhere; host
+// builds turn it on with -DDUAL_CORE=1 to run the std::thread backend.
+//
+
+#include <atomic>
+#include "lcd_compat.h"
+
+#ifndef DUAL_CORE
+#if defined(ARDUINO_ARCH_ESP32) && !CONFIG_FREERTOS_UNICORE
+#define DUAL_CORE 1
+#else
+#define DUAL_CORE 0
+#endif
+#endif
+
+#define CMD_LINE_MAX   160    // longest command line handed to the render task
+#define UI_TEXT_MAX    64
+#define CMD_RING_SIZE  16
+#define UI_RING_SIZE   8
+
+template <typename T, uint16_t N>
+struct SpscRing {
+  T slots[N];
+  std::atomic<uint16_t> head{0};   // next slot to write (producer only)
+  std::atomic<uint16_t> tail{0};   // next slot to read (consumer only)
+
+  bool push(const T& v) {
+    uint16_t h = head.load(std::memory_order_relaxed);
+    uint16_t next = (h + 1) % N;
+    if (next == tail.load(std::memory_order_acquire)) return false;   // full
+    slots[h] = v;
+    head.store(next, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& v) {
+    uint16_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false;      // empty
+    v = slots[t];
+    tail.store((t + 1) % N, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+  }
+};
+
+struct CmdLine {
+  char text[CMD_LINE_MAX];
+};
+
+enum UiKind : uint8_t { UI_STATUS, UI_LCD };
+
+struct UiMsg {
+  UiKind kind;
+  uint16_t ms;
+  char text[UI_TEXT_MAX];
+};
+
+SpscRing<CmdLine, CMD_RING_SIZE> cmdRing;   // UI task → render task
+SpscRing<UiMsg, UI_RING_SIZE> uiRing;       // render task → UI task
+
+#if DUAL_CORE
+#if defined(ARDUINO_ARCH_ESP32)
+TaskHandle_t uiTaskHandle = nullptr;
+inline bool onUiTask() { return xTaskGetCurrentTaskHandle() == uiTaskHandle; }
+#else
+thread_local bool uiThread = false;
+inline bool onUiTask() { return uiThread; }
+#endif
+#else
+inline bool onUiTask() { return true; }     // one task does everything
+#endif
+
+// Render side: queue an OLED message; dropped (with a note) if the UI is behind
+void uiPost(UiKind kind, const String& text, uint16_t ms) {
+  UiMsg m;
+  m.kind = kind;
+  m.ms = ms;
+  strncpy(m.text, text.c_str(), UI_TEXT_MAX - 1);
+  m.text[UI_TEXT_MAX - 1] = '\0';
+  if (!uiRing.push(m)) Serial.println("⚠️ OLED queue full, message dropped");
+}
+
+// Plain text on the OLED (lcd_compat.h), from either task
+void lcdMessage(const String& s) {
+  if (!onUiTask()) {
+    uiPost(UI_LCD, s, 0);
+    return;
+  }
+  lcd.clear();
+  lcd.print(s);
+}
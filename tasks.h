@@ -0,0 +1,106 @@
+#pragma once
+// =====================
+// 🧵 DUAL-CORE TASKS MODULE
+// =====================
+//
+// With DUAL_CORE (taskqueue.h) the work is split across the two ESP32
+// cores so the OLED never stalls a frame:
+//
+//   UI task (core 0)      Serial ingestion, eye commands, status/LCD
+//                         messages and the OLED redraw + I2C flush
+//   loop() (core 1)       every other command (processCommand), effects,
+//                         zones, layers and the LED outputs
+//
+// Nothing is shared between them except the two SPSC rings: command lines
+// UI → render, OLED messages render → UI. processCommand() stays with the
+// renderer because nearly every command rewrites render state.
+//
+// Off the ESP32 the UI task is a std::thread, so host builds with
+// -DDUAL_CORE=1 -fsanitize=thread can check the handoff.
+//
+
+#if DUAL_CORE
+
+#if !defined(ARDUINO_ARCH_ESP32)
+#include <thread>
+#include <chrono>
+#endif
+
+#define UI_TASK_STACK   8192
+#define UI_TASK_PRIO    1
+#define UI_TASK_CORE    0
+#define UI_TASK_TICK_MS 1
+
+// Serial → eyes (handled here) or the render task's command ring
+void uiReadSerial() {
+  while (Serial.available()) {
+    String cmd = Serial.readStringUntil('\n');
+    cmd.trim();
+    if (!cmd.length()) continue;
+    if (Eyes_tryHandleCommand(cmd)) continue;   // OLED-only: never crosses over
+
+    if (cmd.length() >= CMD_LINE_MAX) {
+      Serial.println("⚠️ Command too long, dropped");
+      continue;
+    }
+    CmdLine line;
+    memcpy(line.text, cmd.c_str(), cmd.length() + 1);
+    if (cmdRing.push(line)) {
+      Serial.println("📥 Queued → " + cmd);
+      idleOnReceive();   // wake the render task if it's idling
+    } else {
+      Serial.println("⚠️ Command Queue Full!");
+    }
+  }
+}
+
+// One UI pass: input, messages from the renderer, then the OLED
+void uiTaskStep() {
+  uiReadSerial();
+  UiMsg m;
+  while (uiRing.pop(m)) {
+    if (m.kind == UI_STATUS) statusShow(m.text, m.ms);
+    else lcdMessage(m.text);
+  }
+  Eyes_update();
+  lcd.flush();
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+void uiTaskMain(void*) {
+  for (;;) {
+    uiTaskStep();
+    vTaskDelay(pdMS_TO_TICKS(UI_TASK_TICK_MS));
+  }
+}
+#else
+void uiTaskMain() {
+  uiThread = true;
+  for (;;) {
+    uiTaskStep();
+    std::this_thread::sleep_for(std::chrono::milliseconds(UI_TASK_TICK_MS));
+  }
+}
+#endif
+
+// End of setup(): from here on only the UI task touches Serial input and the OLED
+void tasksBegin() {
+#if defined(ARDUINO_ARCH_ESP32)
+  xTaskCreatePinnedToCore(uiTaskMain, "billu-ui", UI_TASK_STACK, nullptr, UI_TASK_PRIO, &uiTaskHandle, UI_TASK_CORE);
+#else
+  std::thread(uiTaskMain).detach();
+#endif
+  Serial.println("🧵 UI task started (Serial + OLED), rendering on the loop task");
+}
+
+// Render side: run everything the UI task queued since the last pass
+void tasksDrainCommands() {
+  CmdLine line;
+  while (cmdRing.pop(line)) processCommand(String(line.text));
+}
+
+#else
+
+inline void tasksBegin() {}
+
+#endif
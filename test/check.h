@@ -0,0 +1,32 @@
+#pragma once
+// Minimal assertions for the host tests: CHECK() records a failure and
+// carries on, checkDone() prints the tally and gives main()'s exit code.
+#include <cstdio>
+#include <chrono>
+
+int checkFailures = 0;
+int checkCount = 0;
+
+#define CHECK(cond) do { \
+    checkCount++; \
+    if (!(cond)) { checkFailures++; fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); } \
+  } while (0)
+
+#define CHECK_EQ(a, b) do { \
+    checkCount++; \
+    long long va_ = (long long)(a), vb_ = (long long)(b); \
+    if (va_ != vb_) { checkFailures++; fprintf(stderr, "%s:%d: CHECK_EQ failed: %s = %lld, %s = %lld\n", __FILE__, __LINE__, #a, va_, #b, vb_); } \
+  } while (0)
+
+inline int checkDone(const char* name) {
+  printf("%-20s %s (%d checks, %d failed)\n", name, checkFailures ? "FAIL" : "ok", checkCount, checkFailures);
+  return checkFailures ? 1 : 0;
+}
+
+// Wall time of fn(), averaged over reps calls, in ns
+template <typename F>
+double benchNs(int reps, F&& fn) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) fn();
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / reps;
+}
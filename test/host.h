@@ -0,0 +1,48 @@
+#pragma once
+// =====================
+// 🧪 HOST TEST HARNESS
+// =====================
+//
+// Builds the whole sketch into a host test: the stand-ins in stubs/ replace
+// the Arduino core and libraries, and this file supplies the clock. The
+// clock is manual by default (hostAdvance() moves it, delay() moves it) so
+// effect timing is deterministic; hostRealClock = true switches to the
+// steady clock for the threaded tests and benchmarks. The manual clock is
+// atomic because the UI task and render helpers read it too.
+//
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "Arduino.h"
+#include "Wire.h"
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+bool hostRealClock = false;
+std::atomic<unsigned long> hostMs{0};
+std::atomic<uint32_t> hostUs{0};
+
+static const auto hostEpoch = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+  if (!hostRealClock) return hostMs;
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - hostEpoch).count();
+}
+
+unsigned long micros() {
+  if (!hostRealClock) return hostMs * 1000UL + hostUs;
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostEpoch).count();
+}
+
+void delay(unsigned long ms) {
+  if (hostRealClock) std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  else hostMs += ms;
+}
+
+inline void hostAdvance(unsigned long ms) { hostMs += ms; }
+
+#include "../Serialcommand_of_billuai.ino"
+
+#include "check.h"
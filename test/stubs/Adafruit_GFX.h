@@ -0,0 +1,24 @@
+#pragma once
+// Host stand-in: drawing calls do nothing
+#include "Arduino.h"
+
+class Adafruit_GFX {
+public:
+  void setTextSize(int) {}
+  void setTextColor(int) {}
+  void setCursor(int, int) {}
+  void setFont(const void*) {}
+  void setTextWrap(bool) {}
+  void print(const String&) {}
+  void print(const char*) {}
+  void print(int) {}
+  void getTextBounds(const String&, int16_t, int16_t, int16_t* x, int16_t* y, uint16_t* w, uint16_t* h) { *x = *y = 0; *w = *h = 8; }
+  void drawPixel(int, int, int) {}
+  void fillCircle(int, int, int, int) {}
+  void drawCircle(int, int, int, int) {}
+  void drawLine(int, int, int, int, int) {}
+  void fillRect(int, int, int, int, int) {}
+  void drawRect(int, int, int, int, int) {}
+  void fillRoundRect(int, int, int, int, int, int) {}
+  void fillTriangle(int, int, int, int, int, int, int) {}
+};
@@ -0,0 +1,60 @@
+#pragma once
+// Host stand-in for Adafruit_NeoPixel: pixels land in px[], show() counts
+#include <vector>
+#include "Arduino.h"
+
+typedef uint16_t neoPixelType;
+#define NEO_GRB 0x52
+#define NEO_RGB 0x06
+#define NEO_BRG 0x58
+#define NEO_RBG 0x09
+#define NEO_GBR 0xA1
+#define NEO_BGR 0xA4
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel {
+public:
+  std::vector<uint32_t> px;
+  unsigned shows = 0;
+  int16_t pin = -1;
+
+  Adafruit_NeoPixel(uint16_t n, int16_t p = 6, neoPixelType = NEO_GRB + NEO_KHZ800) : pin(p) { px.assign(n, 0); }
+  Adafruit_NeoPixel() {}
+  void begin() {}
+  void show() { shows++; }
+  void clear() { std::fill(px.begin(), px.end(), 0); }
+  void setBrightness(uint8_t) {}
+  uint8_t getBrightness() const { return 0; }
+  void updateLength(uint16_t n) { px.assign(n, 0); }
+  void setPin(int16_t p) { pin = p; }
+  void updateType(neoPixelType) {}
+  void setPixelColor(uint16_t i, uint32_t c) {
+    if (i >= px.size()) { fprintf(stderr, "setPixelColor out of range: %u\n", i); abort(); }
+    px[i] = c;
+  }
+  void setPixelColor(uint16_t i, uint8_t r, uint8_t g, uint8_t b) { setPixelColor(i, Color(r, g, b)); }
+  uint32_t getPixelColor(uint16_t i) const { return i < px.size() ? px[i] : 0; }
+  uint8_t* getPixels() const { return nullptr; }
+  uint16_t numPixels() const { return px.size(); }
+  bool canShow() { return true; }
+
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) { return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b; }
+  // Same hue wheel as the library (1530 steps)
+  static uint32_t ColorHSV(uint16_t hue, uint8_t sat = 255, uint8_t val = 255) {
+    uint8_t r, g, b;
+    hue = (hue * 1530L + 32768) / 65536;
+    if (hue < 510) { b = 0; if (hue < 255) { r = 255; g = hue; } else { r = 510 - hue; g = 255; } }
+    else if (hue < 1020) { r = 0; if (hue < 765) { g = 255; b = hue - 510; } else { g = 1020 - hue; b = 255; } }
+    else if (hue < 1530) { g = 0; if (hue < 1275) { r = hue - 1020; b = 255; } else { r = 255; b = 1530 - hue; } }
+    else { r = 255; g = b = 0; }
+    uint32_t v1 = 1 + val;
+    uint16_t s1 = 1 + sat;
+    uint8_t s2 = 255 - sat;
+    return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
+           (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
+           (((((b * s1) >> 8) + s2) * v1) >> 8);
+  }
+  static uint32_t gamma32(uint32_t x) { return x; }
+  static uint8_t gamma8(uint8_t x) { return x; }
+  static uint8_t sine8(uint8_t x) { return x; }
+};
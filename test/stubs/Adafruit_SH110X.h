@@ -0,0 +1,19 @@
+#pragma once
+// Host stand-in for the SH1106 driver
+#include "Adafruit_GFX.h"
+#include "Wire.h"
+
+#define SH110X_WHITE 1
+#define SH110X_BLACK 0
+
+class Adafruit_SH110X : public Adafruit_GFX {
+public:
+  void clearDisplay() {}
+  void display() {}
+  bool begin(uint8_t, bool) { return true; }
+};
+
+class Adafruit_SH1106G : public Adafruit_SH110X {
+public:
+  Adafruit_SH1106G(int, int, TwoWire*, int) {}
+};
@@ -0,0 +1,113 @@
+#pragma once
+// Host stand-in for the Arduino core: just enough for the sketch to build
+// and run under g++ (see test/Makefile). Time comes from test/host.h.
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <mutex>
+#include <deque>
+using std::max;
+using std::min;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define PI 3.14159265358979f
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define INPUT 0
+#define constrain(x, a, b) ((x) < (a) ? (a) : ((x) > (b) ? (b) : (x)))
+
+inline long map(long x, long a, long b, long c, long d) { return (x - a) * (d - c) / (b - a) + c; }
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+inline void delayMicroseconds(unsigned int) {}
+inline long random(long n) { return n > 0 ? rand() % n : 0; }
+inline long random(long a, long b) { return b > a ? a + random(b - a) : a; }
+inline void randomSeed(unsigned long s) { srand(s); }
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+
+class String {
+public:
+  std::string s;
+  String() {}
+  String(const char* c) : s(c ? c : "") {}
+  String(const std::string& x) : s(x) {}
+  String(char c) : s(1, c) {}
+  String(int v) : s(std::to_string(v)) {}
+  String(unsigned v) : s(std::to_string(v)) {}
+  String(long v) : s(std::to_string(v)) {}
+  String(unsigned long v) : s(std::to_string(v)) {}
+  String(float v, int d = 2) { char b[32]; snprintf(b, sizeof b, "%.*f", d, v); s = b; }
+  String(double v, int d = 2) { char b[32]; snprintf(b, sizeof b, "%.*f", d, v); s = b; }
+  unsigned length() const { return s.size(); }
+  String substring(unsigned a) const { return a < s.size() ? s.substr(a) : ""; }
+  String substring(unsigned a, unsigned b) const { return (a < s.size() && b > a) ? s.substr(a, b - a) : ""; }
+  int indexOf(char c, unsigned f = 0) const { auto p = s.find(c, f); return p == std::string::npos ? -1 : (int)p; }
+  int indexOf(const String& c, unsigned f = 0) const { auto p = s.find(c.s, f); return p == std::string::npos ? -1 : (int)p; }
+  int lastIndexOf(char c) const { auto p = s.rfind(c); return p == std::string::npos ? -1 : (int)p; }
+  long toInt() const { return atol(s.c_str()); }
+  float toFloat() const { return atof(s.c_str()); }
+  void trim() {
+    size_t a = s.find_first_not_of(" \t\r\n"), b = s.find_last_not_of(" \t\r\n");
+    s = (a == std::string::npos) ? "" : s.substr(a, b - a + 1);
+  }
+  void toLowerCase() { for (auto& c : s) c = tolower((unsigned char)c); }
+  void toUpperCase() { for (auto& c : s) c = toupper((unsigned char)c); }
+  bool equals(const String& o) const { return s == o.s; }
+  bool equalsIgnoreCase(const String& o) const { String a = *this, b = o; a.toLowerCase(); b.toLowerCase(); return a.s == b.s; }
+  bool startsWith(const String& o) const { return s.rfind(o.s, 0) == 0; }
+  bool endsWith(const String& o) const { return s.size() >= o.s.size() && s.compare(s.size() - o.s.size(), o.s.size(), o.s) == 0; }
+  bool operator==(const String& o) const { return s == o.s; }
+  bool operator==(const char* o) const { return s == o; }
+  bool operator!=(const String& o) const { return s != o.s; }
+  bool operator!=(const char* o) const { return s != o; }
+  String& operator+=(const String& o) { s += o.s; return *this; }
+  String& operator+=(char c) { s += c; return *this; }
+  char operator[](unsigned i) const { return s[i]; }
+  char charAt(unsigned i) const { return s[i]; }
+  void setCharAt(unsigned i, char c) { if (i < s.size()) s[i] = c; }
+  void reserve(unsigned n) { s.reserve(n); }
+  const char* c_str() const { return s.c_str(); }
+  void replace(const String& a, const String& b) {
+    if (a.s.empty()) return;
+    for (size_t p = 0; (p = s.find(a.s, p)) != std::string::npos; p += b.s.size()) s.replace(p, a.s.size(), b.s);
+  }
+};
+inline String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+inline String operator+(const String& a, const char* b) { return String(a.s + b); }
+inline String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+
+// Serial: output is dropped; tests feed input lines with feed()
+struct HardwareSerial {
+  std::mutex inLock;
+  std::deque<std::string> in;
+  void feed(const std::string& l) { std::lock_guard<std::mutex> g(inLock); in.push_back(l); }
+  void begin(long) {}
+  int available() { std::lock_guard<std::mutex> g(inLock); return in.empty() ? 0 : (int)in.front().size() + 1; }
+  int read() { return -1; }
+  String readStringUntil(char) {
+    std::lock_guard<std::mutex> g(inLock);
+    if (in.empty()) return "";
+    std::string l = in.front();
+    in.pop_front();
+    return String(l);
+  }
+  size_t readBytes(char*, size_t) { return 0; }
+  template <class T> void print(T) {}
+  template <class T> void print(T, int) {}
+  template <class T> void println(T) {}
+  template <class T> void println(T, int) {}
+  void println() {}
+  void printf(const char*, ...) {}
+  operator bool() { return true; }
+};
+extern HardwareSerial Serial;
@@ -0,0 +1,26 @@
+#pragma once
+// Host stand-in for RoboEyes: accepts every call, draws nothing
+#include "Arduino.h"
+
+enum { DEFAULT = 0, TIRED, ANGRY, HAPPY, N, NE, E, SE, S, SW, W, NW };
+#define ON 1
+#define OFF 0
+
+struct roboEyes {
+  void begin(int, int, int) {}
+  void update() {}
+  void setPosition(int) {}
+  void setWidth(int, int) {}
+  void setHeight(int, int) {}
+  void setBorderradius(int, int) {}
+  void setSpacebetween(int) {}
+  void setCuriosity(bool) {}
+  void setAutoblinker(bool, int = 0, int = 0) {}
+  void setIdleMode(bool, int = 0, int = 0) {}
+  void setMood(int) {}
+  void setHFlicker(bool, int = 0) {}
+  void setVFlicker(bool, int = 0) {}
+  void blink() {}
+  void anim_confused() {}
+  void anim_laugh() {}
+};
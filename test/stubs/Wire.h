@@ -0,0 +1,9 @@
+#pragma once
+#include "Arduino.h"
+
+struct TwoWire {
+  void begin() {}
+  void begin(int, int) {}
+  void setClock(uint32_t) {}
+};
+extern TwoWire Wire;
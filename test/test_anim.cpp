@@ -0,0 +1,213 @@
+// anim.h: BAN1 files decoded from ANIM_HOST_DIR (build/anim/, set by the
+// Makefile): RLE and literal runs, the 0-byte hold frame, loop counts,
+// truncated or corrupt files refused, and cropping to ledStart..ledEnd
+#include <sys/stat.h>
+#include "host.h"
+
+// Palette of every test file: index → color
+const uint8_t PAL[4][3] = { { 0, 0, 0 }, { 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 } };
+
+static uint32_t palColor(uint8_t i) { return strip.Color(PAL[i][0], PAL[i][1], PAL[i][2]); }
+
+static void put16(std::vector<uint8_t>& b, uint16_t v) {
+  b.push_back(v & 0xFF);
+  b.push_back(v >> 8);
+}
+
+// Header + palette for frames × len pixels
+static std::vector<uint8_t> banHeader(uint16_t len, uint16_t frames, uint16_t ms) {
+  std::vector<uint8_t> b = { 'B', 'A', 'N', '1' };
+  put16(b, len);
+  put16(b, frames);
+  put16(b, ms);
+  b.push_back(4);
+  b.insert(b.end(), 5, 0);
+  for (const auto& c : PAL) b.insert(b.end(), c, c + 3);
+  return b;
+}
+
+static void banFrame(std::vector<uint8_t>& b, const std::vector<uint8_t>& payload) {
+  put16(b, payload.size());
+  b.insert(b.end(), payload.begin(), payload.end());
+}
+
+static void banWrite(const char* name, const std::vector<uint8_t>& b) {
+  FILE* f = fopen((String(ANIM_HOST_DIR) + name + ".ban").c_str(), "wb");
+  CHECK(f != nullptr);
+  if (!f) return;
+  fwrite(b.data(), 1, b.size(), f);
+  fclose(f);
+}
+
+// One due frame
+static void tick() {
+  hostAdvance(1000);
+  updateAnimation();
+}
+
+// frame[from..] holds the palette colors of want
+static void checkPixels(uint16_t from, const std::vector<uint8_t>& want) {
+  for (size_t i = 0; i < want.size(); i++) CHECK_EQ(frame[from + i], palColor(want[i]));
+}
+
+// 4 × red as a run, green blue black as literals, 3 × blue as a run
+const std::vector<uint8_t> RUNS = { 0x83, 1, 0x02, 2, 3, 0, 0x82, 3 };
+const std::vector<uint8_t> RUNS_PX = { 1, 1, 1, 1, 2, 3, 0, 3, 3, 3 };
+// One literal run of all ten
+const std::vector<uint8_t> LIT = { 0x09, 3, 2, 1, 0, 3, 2, 1, 0, 3, 2 };
+const std::vector<uint8_t> LIT_PX = { 3, 2, 1, 0, 3, 2, 1, 0, 3, 2 };
+
+static void testRuns() {
+  std::vector<uint8_t> b = banHeader(10, 2, 40);
+  banFrame(b, RUNS);
+  banFrame(b, LIT);
+  banWrite("runs", b);
+
+  CHECK(animStart("runs", 1, 100));
+  CHECK_EQ(anim.len, 10);
+  CHECK_EQ(anim.frames, 2);
+  CHECK_EQ(anim.frameMs, 40);
+  tick();
+  checkPixels(0, RUNS_PX);
+  tick();
+  checkPixels(0, LIT_PX);
+  tick();
+  CHECK(!animPlaying);      // one loop, done
+}
+
+// A 0-byte payload leaves the previous frame up
+static void testHold() {
+  std::vector<uint8_t> b = banHeader(10, 3, 40);
+  banFrame(b, RUNS);
+  banFrame(b, {});
+  banFrame(b, LIT);
+  banWrite("hold", b);
+
+  CHECK(animStart("hold", 1, 100));
+  tick();
+  checkPixels(0, RUNS_PX);
+  frameDirty = false;
+  tick();
+  CHECK(animPlaying);
+  CHECK(!frameDirty);       // nothing redrawn
+  checkPixels(0, RUNS_PX);
+  tick();
+  checkPixels(0, LIT_PX);
+}
+
+// loops n plays the file n times then stops; 0 never stops
+static void testLoops() {
+  std::vector<uint8_t> b = banHeader(10, 2, 40);
+  banFrame(b, RUNS);
+  banFrame(b, LIT);
+  banWrite("loop", b);
+
+  CHECK(animStart("loop", 3, 100));
+  for (int i = 0; i < 3; i++) {
+    tick();
+    checkPixels(0, RUNS_PX);
+    tick();
+    checkPixels(0, LIT_PX);
+  }
+  tick();
+  CHECK(!animPlaying);
+  CHECK_EQ(anim.loopsDone, 3);
+
+  CHECK(animStart("loop", 0, 100));
+  for (int i = 0; i < 50; i++) tick();
+  CHECK(animPlaying);
+  animStop();
+}
+
+// Refused at start: nothing plays
+static void checkRefused(const char* name, const std::vector<uint8_t>& b) {
+  banWrite(name, b);
+  CHECK(!animStart(name, 0, 100));
+  CHECK(!animPlaying);
+}
+
+// Accepted, then stopped at the first bad frame
+static void checkStopsAtFrame(const char* name, const std::vector<uint8_t>& b) {
+  banWrite(name, b);
+  CHECK(animStart(name, 0, 100));
+  tick();
+  CHECK(!animPlaying);
+}
+
+static void testRejects() {
+  CHECK(!animStart("missing", 0, 100));
+
+  std::vector<uint8_t> good = banHeader(10, 1, 40);
+  checkRefused("short_header", std::vector<uint8_t>(good.begin(), good.begin() + 10));
+  std::vector<uint8_t> b = good;
+  b[3] = '2';
+  checkRefused("magic", b);
+  checkRefused("short_palette", std::vector<uint8_t>(good.begin(), good.end() - 2));
+  checkRefused("no_frames", banHeader(10, 0, 40));
+  checkRefused("no_pixels", banHeader(0, 1, 40));
+
+  // Payload size past the end of the file
+  b = good;
+  put16(b, RUNS.size() + 4);
+  b.insert(b.end(), RUNS.begin(), RUNS.end());
+  checkStopsAtFrame("short_payload", b);
+
+  // Frame-size prefix cut in half
+  b = good;
+  b.push_back(8);
+  checkStopsAtFrame("short_size", b);
+
+  // Runs that cover fewer pixels than the frame
+  b = good;
+  banFrame(b, { 0x83, 1 });
+  checkStopsAtFrame("few_pixels", b);
+
+  // A literal run longer than its payload
+  b = good;
+  banFrame(b, { 0x09, 1, 2, 3 });
+  banFrame(b, RUNS);
+  checkStopsAtFrame("literal_overrun", b);
+
+  // A run control byte with no index after it
+  b = good;
+  banFrame(b, { 0x02, 1, 2, 3, 0x85 });
+  checkStopsAtFrame("run_overrun", b);
+}
+
+// A file wider than the range is cropped to it; one narrower leaves the
+// rest of the range alone
+static void testCrop() {
+  std::vector<uint8_t> b = banHeader(10, 1, 40);
+  banFrame(b, RUNS);
+  banWrite("crop", b);
+
+  const uint32_t mark = 0x123456;
+  ledStart = 100; ledEnd = 105;
+  for (uint16_t i = 90; i < 120; i++) setPixel(i, mark);
+  CHECK(animStart("crop", 1, 100));
+  tick();
+  for (uint16_t i = 90; i < 100; i++) CHECK_EQ(frame[i], mark);
+  checkPixels(100, std::vector<uint8_t>(RUNS_PX.begin(), RUNS_PX.begin() + 6));
+  for (uint16_t i = 106; i < 120; i++) CHECK_EQ(frame[i], mark);
+
+  ledStart = 100; ledEnd = 149;
+  CHECK(animStart("crop", 1, 100));
+  tick();
+  checkPixels(100, RUNS_PX);
+  for (uint16_t i = 110; i < 120; i++) CHECK_EQ(frame[i], mark);
+
+  ledStart = 0; ledEnd = numLeds - 1;
+  animStop();
+}
+
+int main() {
+  mkdir(ANIM_HOST_DIR, 0755);
+  setup();
+  CHECK(animFsReady);
+  testRuns();
+  testHold();
+  testLoops();
+  testRejects();
+  testCrop();
+  return checkDone("anim");
+}
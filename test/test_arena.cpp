@@ -0,0 +1,102 @@
+// stripconfig.h: the per-LED arena's footprint and layout, and a boot that
+// can't get it. --bench reboots the strip at 300, 1200 and 4096 LEDs and
+// times a rendered, committed frame against the arena it takes.
+#include "host.h"
+
+// calloc() that fails on demand (the arena is the only calloc in stripBegin())
+extern "C" void* __libc_calloc(size_t, size_t);
+bool hostCallocFails = false;
+extern "C" void* calloc(size_t n, size_t size) {
+  return hostCallocFails ? nullptr : __libc_calloc(n, size);
+}
+
+// Out of RAM at boot: nothing assigned, numLeds and the outputs untouched
+static void testNoRam() {
+  uint16_t before = numLeds;
+  hostCallocFails = true;
+  bool ok = stripBegin();
+  hostCallocFails = false;
+  CHECK(!ok);
+  CHECK(arena == nullptr);
+  CHECK(frame == nullptr);
+  CHECK_EQ(arenaSize, 0);
+  CHECK_EQ(numLeds, before);
+  CHECK_EQ(strip.numPixels(), 0);
+}
+
+// Every slice inside the arena, in order, and arenaBytesFor() exact
+static void testLayout(uint16_t n) {
+  uint8_t* keep = arena;
+  size_t keepSize = arenaSize;
+  arenaSize = arenaBytesFor(n);
+  arena = (uint8_t*)calloc(1, arenaSize);
+  arenaAssign(n);
+
+  CHECK_EQ(arenaUsed, arenaSize);
+  const uint8_t* slices[] = {
+    (uint8_t*)frame, (uint8_t*)keyPrev, (uint8_t*)fadeFrom,
+    (uint8_t*)layerBuf[0], (uint8_t*)layerBuf[LAYER_COUNT - 1],
+    scrollBaseIdx, baseCache.idx, zoneBaseStore, fireHeat, fireNoise, waveLevels,
+  };
+  for (size_t s = 1; s < sizeof(slices) / sizeof(slices[0]); s++) CHECK(slices[s] > slices[s - 1]);
+  CHECK(waveLevels + n <= arena + arenaSize);
+  CHECK(scrollBaseStore.idx == scrollBaseIdx);
+  CHECK(drawTarget == frame);
+
+  free(arena);
+  arena = keep;
+  arenaSize = keepSize;
+  arenaAssign(numLeds);
+}
+
+// 30 arena bytes per LED (6 RGB words, 6 index/scratch bytes) + 3 in
+// NeoPixel: the "about 33 bytes per LED" in stripconfig.h
+static void testFootprint() {
+  const uint16_t ns[] = { 1, 2, 3, 4, 5, 300, 1000, 1001, STRIP_MAX_LEDS };
+  for (uint16_t n : ns) {
+    size_t bytes = arenaBytesFor(n);
+    CHECK(bytes >= (size_t)n * 30);
+    CHECK(bytes <= (size_t)n * 30 + 6 * 3);
+    if (n % 4 == 0) CHECK_EQ(bytes, (size_t)n * 30);
+    testLayout(n);
+  }
+  CHECK(arenaBytesFor(STRIP_MAX_LEDS) + 3 * STRIP_MAX_LEDS <= 33 * STRIP_MAX_LEDS);
+}
+
+// Boot again with one output of n LEDs (what a saved CMD:STRIP= does)
+static void rebootStrip(uint16_t n) {
+  free(arena);
+  arena = nullptr;
+  outputConfig[0].leds = n;
+  mapRunCount = 0;
+  CHECK(stripBegin());
+  CHECK_EQ(numLeds, n);
+  processCommand("CMD:LED=ON");
+}
+
+static void bench() {
+  const uint16_t lens[] = { 300, 1200, STRIP_MAX_LEDS };
+  const char* const effects[] = { "wave", "rainbow" };
+  for (uint16_t n : lens) {
+    rebootStrip(n);
+    for (const char* name : effects) {
+      processCommand("CMD:EFFECT=" + String(name));
+      processCommand("CMD:LOOPCACHE=OFF");   // time the render, not a replay
+      double ns = benchNs(400, [] { hostAdvance(1000); runCurrentEffect(); commitFrame(); });
+      processCommand("CMD:LOOPCACHE=ON");
+      printf("  %5u LEDs  arena %7u bytes  %-8s %8.0f ns/frame\n", n, (unsigned)arenaSize, name, ns);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  testNoRam();
+  setup();
+  CHECK(arena != nullptr);
+  CHECK_EQ(arenaSize, arenaBytesFor(numLeds));
+  CHECK_EQ(arenaUsed, arenaSize);
+  CHECK_EQ(numLeds, DEFAULT_NUM_LEDS);
+  testFootprint();
+  if (argc > 1 && !strcmp(argv[1], "--bench")) bench();
+  return checkDone("arena");
+}
@@ -0,0 +1,94 @@
+// fastrand.h: range contracts, output quality and speed against random()
+#include "Arduino.h"
+#include "../fastrand.h"
+#include "check.h"
+
+static void testRanges() {
+  rngSeed(1);
+  bool lo = false, hi = false;
+  for (int i = 0; i < 100000; i++) {
+    int32_t v = rngBelow(10);
+    CHECK(v >= 0 && v < 10);
+    int32_t r = rngRange(-5, 5);
+    CHECK(r >= -5 && r < 5);
+  }
+  CHECK_EQ(rngBelow(0), 0);
+  CHECK_EQ(rngRange(7, 7), 7);
+  CHECK_EQ(rngRange(9, 3), 9);
+
+  // Byte helper is inclusive at both ends
+  for (int b = 0; b < 256; b++) {
+    uint8_t v = rngByteRange(b, 200, 255);
+    CHECK(v >= 200 && v <= 255);
+    if (v == 200) lo = true;
+    if (v == 255) hi = true;
+    CHECK_EQ(rngByteRange(b, 0, 255), b);
+  }
+  CHECK(lo && hi);
+  CHECK_EQ(rngByteRange(123, 40, 40), 40);
+
+  uint8_t buf[37];
+  rngFillRange(buf, sizeof buf, 160, 255);
+  for (uint8_t v : buf) CHECK(v >= 160);
+}
+
+static void testSeeding() {
+  rngSeed(42);
+  uint32_t a = rngNext(), b = rngNext();
+  rngSeed(42);
+  CHECK_EQ(rngNext(), a);
+  CHECK_EQ(rngNext(), b);
+  rngSeed(0);                       // 0 would lock xorshift at 0
+  CHECK(rngNext() != 0);
+}
+
+static void testQuality() {
+  const int n = 1 << 20;
+  rngSeed(12345);
+
+  // Every bit set about half the time
+  uint32_t bits[32] = {};
+  uint32_t bytes[256] = {};
+  for (int i = 0; i < n; i++) {
+    uint32_t r = rngNext();
+    CHECK(r != 0);
+    for (int b = 0; b < 32; b++) bits[b] += (r >> b) & 1;
+    bytes[r & 0xFF]++;
+  }
+  for (int b = 0; b < 32; b++) CHECK(fabs((double)bits[b] / n - 0.5) < 0.005);
+
+  // Chi-square of the low byte over 255 degrees of freedom (p ≈ 0.001 at 330)
+  double expect = n / 256.0, chi = 0;
+  for (int v = 0; v < 256; v++) chi += (bytes[v] - expect) * (bytes[v] - expect) / expect;
+  CHECK(chi < 330);
+
+  // rngBelow spreads evenly over a non-power-of-two range
+  uint32_t bins[6] = {};
+  for (int i = 0; i < n; i++) bins[rngBelow(6)]++;
+  for (int k = 0; k < 6; k++) CHECK(fabs(bins[k] / (n / 6.0) - 1.0) < 0.01);
+
+  // rngFill uses all four bytes of each step: no repeats across lanes
+  uint8_t buf[4096];
+  rngFill(buf, sizeof buf);
+  uint32_t fill[256] = {};
+  for (uint8_t v : buf) fill[v]++;
+  for (int v = 0; v < 256; v++) CHECK(fill[v] > 0);
+}
+
+static void benchSpeed() {
+  volatile uint32_t sink = 0;
+  const int reps = 1 << 22;
+  double tRng = benchNs(reps, [&] { sink += rngBelow(300); });
+  double tLib = benchNs(reps, [&] { sink += random(300); });
+  uint8_t buf[300];
+  double tFill = benchNs(reps / 300, [&] { rngFill(buf, sizeof buf); sink += buf[7]; });
+  printf("  rngBelow %.2f ns, random() %.2f ns, rngFill(300) %.1f ns\n", tRng, tLib, tFill);
+}
+
+int main(int argc, char** argv) {
+  testRanges();
+  testSeeding();
+  testQuality();
+  if (argc > 1 && !strcmp(argv[1], "--bench")) benchSpeed();
+  return checkDone("fastrand");
+}
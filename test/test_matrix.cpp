@@ -0,0 +1,234 @@
+// matrix.h: XY() and column tables for both wirings, the layouts
+// matrixBegin() / CMD:MATRIX= must refuse, and the 2-D shapes of WAVE,
+// CENTER_WAVE, RAIN and FIREWORKS on a 16x16 panel. --bench times a panel
+// frame of each against the 60 fps budget.
+#include "host.h"
+
+const char* const MATRIX_EFFECTS[] = { "wave", "center_wave", "rain", "fireworks" };
+
+// Every cell maps to a distinct offset inside the grid
+static void checkPermutation() {
+  uint16_t n = matrixCells();
+  std::vector<bool> seen(n, false);
+  for (uint8_t y = 0; y < matrixH; y++) {
+    for (uint8_t x = 0; x < matrixW; x++) {
+      uint16_t i = XY(x, y);
+      CHECK(i < n);
+      if (i < n) { CHECK(!seen[i]); seen[i] = true; }
+      CHECK_EQ(matrixColumn[(uint16_t)x * matrixH + y], i);
+    }
+  }
+}
+
+static void testSerpentine() {
+  CHECK(matrixBegin(4, 3, true));
+  // row 0 →, row 1 ←, row 2 →
+  const uint16_t want[3][4] = { { 0, 1, 2, 3 }, { 7, 6, 5, 4 }, { 8, 9, 10, 11 } };
+  for (uint8_t y = 0; y < 3; y++)
+    for (uint8_t x = 0; x < 4; x++) CHECK_EQ(XY(x, y), want[y][x]);
+  checkPermutation();
+
+  // Falling particles walk a column top to bottom
+  CHECK_EQ(matrixColumn[1 * 3 + 0], 1);
+  CHECK_EQ(matrixColumn[1 * 3 + 1], 6);
+  CHECK_EQ(matrixColumn[1 * 3 + 2], 9);
+}
+
+static void testProgressive() {
+  uint32_t serpKey = matrixKey();
+  CHECK(matrixBegin(4, 3, false));
+  for (uint8_t y = 0; y < 3; y++)
+    for (uint8_t x = 0; x < 4; x++) CHECK_EQ(XY(x, y), y * 4 + x);
+  checkPermutation();
+  CHECK(matrixKey() != serpKey);
+
+  CHECK(matrixBegin(16, 16, true));
+  checkPermutation();
+  CHECK_EQ(XY(0, 15), 15 * 16 + 15);
+  CHECK_EQ(XY(15, 15), 15 * 16);
+}
+
+// Grid needs the whole range to go 2-D
+static void testActive() {
+  CHECK(matrixBegin(10, 10, true));
+  ledStart = 0; ledEnd = numLeds - 1;
+  CHECK(matrixActive());
+  ledStart = 50; ledEnd = 148;        // 99 pixels
+  CHECK(!matrixActive());
+  ledEnd = 149;
+  CHECK(matrixActive());
+  ledStart = 0; ledEnd = numLeds - 1;
+}
+
+static void testRejects() {
+  CHECK(matrixBegin(5, 5, true));
+  CHECK(!matrixBegin(0, 4, true));
+  CHECK(!matrixBegin(4, 0, true));
+  CHECK(!matrixBegin(MATRIX_MAX_SIDE + 1, 1, true));
+  CHECK(!matrixBegin(20, 16, true));  // 320 > numLeds
+  CHECK(matrixMode);                  // a refused layout keeps the old one
+  CHECK_EQ(matrixW, 5);
+
+  // Widths past uint8_t must not wrap into a valid side
+  processCommand("CMD:MATRIX=300,1");
+  CHECK_EQ(matrixW, 5);
+  processCommand("CMD:MATRIX=8");
+  CHECK_EQ(matrixW, 5);
+  processCommand("CMD:MATRIX=-3,4");
+  CHECK_EQ(matrixW, 5);
+
+  processCommand("CMD:MATRIX=6,5,prog");
+  CHECK_EQ(matrixW, 6);
+  CHECK_EQ(matrixH, 5);
+  CHECK(!matrixSerpentine);
+  processCommand("CMD:MATRIX=OFF");
+  CHECK(!matrixMode);
+  CHECK(matrixXY == nullptr);
+  CHECK(!matrixActive());
+}
+
+// ======================
+// 🔲 PANEL RENDERS (16x16 serpentine over LEDs 0..255)
+// ======================
+static void usePanel() {
+  processCommand("CMD:MATRIX=OFF");
+  processCommand("CMD:LEDRANGE=0,255");
+  processCommand("CMD:MATRIX=16,16");
+  processCommand("CMD:COLOR=white");
+  CHECK(matrixActive());
+}
+
+// Start effect name fresh; each tick is a keyframe
+static void startEffect(const char* name) {
+  processCommand("CMD:EFFECT=" + String(name));
+  hostAdvance(1000);
+}
+
+static void renderTick() {
+  hostAdvance(1000);
+  runCurrentEffect();
+}
+
+static inline uint32_t cell(uint8_t x, uint8_t y) { return frame[XY(x, y)]; }
+
+static inline uint8_t blue(uint32_t c) { return c & 0xFF; }
+
+// Diagonal bands: a cell's level depends on x + y only
+static void testWave() {
+  startEffect("wave");
+  for (int t = 0; t < 8; t++) {
+    renderTick();
+    uint32_t diff = 0, distinct = 0;
+    for (uint8_t y = 1; y < 16; y++)
+      for (uint8_t x = 0; x < 15; x++) diff += cell(x, y) != cell(x + 1, y - 1);
+    for (uint8_t x = 1; x < 16; x++) distinct += cell(x, 0) != cell(x - 1, 0);
+    CHECK_EQ(diff, 0);
+    CHECK(distinct > 0);
+  }
+}
+
+// Rings: symmetric about both center lines and the diagonal, dimmer and
+// brighter bands out from the center
+static void testRings() {
+  startEffect("center_wave");
+  for (int t = 0; t < 8; t++) {
+    renderTick();
+    uint32_t diff = 0;
+    for (uint8_t y = 0; y < 16; y++) {
+      for (uint8_t x = 0; x < 16; x++) {
+        diff += cell(x, y) != cell(15 - x, y);
+        diff += cell(x, y) != cell(x, 15 - y);
+        diff += cell(x, y) != cell(y, x);
+      }
+    }
+    CHECK_EQ(diff, 0);
+    CHECK(cell(7, 7) != cell(0, 7));
+  }
+}
+
+// Drops fall down columns with their tails above them: a drop's head (a
+// lit cell no dimmer than the one below) inside the panel has its tail, a
+// lit cell no brighter, right above it; in time drops reach the bottom row
+static void testRain() {
+  processCommand("CMD:RAIN=light");
+  hostAdvance(1000);
+  bool bottom = false;
+  uint32_t tails = 0;
+  for (int t = 0; t < 60; t++) {
+    renderTick();
+    for (uint8_t x = 0; x < 16; x++) {
+      for (uint8_t y = 0; y < 16; y++) {
+        uint8_t b = blue(cell(x, y));
+        if (!b) continue;
+        CHECK_EQ(cell(x, y) >> 16, 0);                    // rain blue, no lightning
+        bool head = (y == 15) || b >= blue(cell(x, y + 1));
+        if (head && y > 0 && y < 15) {
+          CHECK(blue(cell(x, y - 1)) > 0);
+          CHECK(blue(cell(x, y - 1)) <= b);
+          tails++;
+        }
+        if (y == 15) bottom = true;
+      }
+    }
+  }
+  CHECK(tails > 0);
+  CHECK(bottom);
+}
+
+// Bursts are rings around their centers: a burst alone on the panel
+// lights only cells about its radius away
+static void testFireworks() {
+  startEffect("fireworks");
+  int alone = 0;
+  for (int t = 0; t < 200 && alone < 5; t++) {
+    renderTick();
+    int live = -1, count = 0;
+    for (uint8_t b = 0; b < MATRIX_BURSTS; b++)
+      if (fx->bursts[b].age != 0xFF) { live = b; count++; }
+    if (count != 1 || fx->bursts[live].age < keyStep) continue;
+    alone++;
+    const MatrixBurst& m = fx->bursts[live];
+    float r = (m.age - keyStep) * 0.45f;
+    uint32_t inside = 0, outside = 0;
+    for (uint8_t y = 0; y < 16; y++) {
+      for (uint8_t x = 0; x < 16; x++) {
+        float dx = (float)x - m.x, dy = (float)y - m.y;
+        bool onRing = fabsf(sqrtf(dx * dx + dy * dy) - r) < 1.3f;
+        if (cell(x, y)) (onRing ? inside : outside)++;
+      }
+    }
+    CHECK(inside > 0);
+    CHECK_EQ(outside, 0);
+  }
+  CHECK(alone > 0);
+}
+
+// Effect + commit for one panel frame, per effect, against 16.7 ms
+static void bench() {
+  processCommand("CMD:LOOPCACHE=OFF");   // time the render, not a replay
+  for (const char* name : MATRIX_EFFECTS) {
+    if (!strcmp(name, "rain")) processCommand("CMD:RAIN=heavy");
+    else startEffect(name);
+    double ns = benchNs(2000, [] { renderTick(); commitFrame(); });
+    printf("  %-12s 16x16  %8.0f ns/frame  %5.2f%% of 16.7 ms\n", name, ns, ns / 16.7e6 * 100.0);
+  }
+  processCommand("CMD:LOOPCACHE=ON");
+}
+
+int main(int argc, char** argv) {
+  setup();
+  CHECK_EQ(numLeds, 300);
+  testSerpentine();
+  testProgressive();
+  testActive();
+  testRejects();
+
+  processCommand("CMD:LED=ON");
+  usePanel();
+  testWave();
+  testRings();
+  testRain();
+  testFireworks();
+  if (argc > 1 && !strcmp(argv[1], "--bench")) bench();
+  return checkDone("matrix");
+}
@@ -0,0 +1,98 @@
+// parallel.h: split renders match inline ones pixel for pixel, and what a
+// split costs or saves at 1200-4096 LEDs (--bench). Built with
+// -DPAR_WORKERS=3 (Makefile), so the host runs four slices on std::threads;
+// on a one-core machine the split can only lose.
+#include <unistd.h>
+#include "host.h"
+
+const char* const PAR_EFFECTS[] = { "wave", "center_wave", "bounce_wave", "rainbow" };
+
+static void useRange(uint16_t len) {
+  processCommand("CMD:LEDRANGE=0," + String(len - 1));
+}
+
+// Start effect name fresh with the given split setting
+static void startEffect(const char* name, bool split) {
+  parEnabled = split;
+  processCommand("CMD:EFFECT=" + String(name));
+  hostAdvance(1000);
+}
+
+// One tick of the current effect
+static void renderTick() {
+  hostAdvance(1000);
+  runCurrentEffect();
+}
+
+static void testMatchesInline(uint16_t len) {
+  useRange(len);
+  std::vector<uint32_t> inlineFrames;
+  for (const char* name : PAR_EFFECTS) {
+    inlineFrames.clear();
+    startEffect(name, false);
+    for (int t = 0; t < 40; t++) {
+      renderTick();
+      inlineFrames.insert(inlineFrames.end(), frame, frame + len);
+    }
+
+    uint32_t split = parSplitPasses;
+    startEffect(name, true);
+    uint32_t diffs = 0;
+    for (int t = 0; t < 40; t++) {
+      renderTick();
+      for (uint16_t i = 0; i < len; i++) diffs += frame[i] != inlineFrames[(size_t)t * len + i];
+    }
+    CHECK_EQ(diffs, 0);
+    CHECK(parSplitPasses > split);   // really split, not a cache replay
+  }
+}
+
+// Short ranges and OFF stay inline
+static void testInlineCases() {
+  useRange(PAR_MIN_LEDS - 1);
+  startEffect("rainbow", true);
+  uint32_t split = parSplitPasses;
+  renderTick();
+  CHECK_EQ(parSplitPasses, split);
+
+  useRange(2000);
+  startEffect("fire_glow", true);   // not marked parallel
+  renderTick();
+  CHECK_EQ(parSplitPasses, split);
+}
+
+static void bench() {
+  printf("  %u hardware threads, %d slices\n", std::thread::hardware_concurrency(), PAR_WORKERS + 1);
+  const uint16_t lens[] = { 1200, 2400, 4096 };
+  for (const char* name : PAR_EFFECTS) {
+    for (uint16_t len : lens) {
+      useRange(len);
+      double ns[2];
+      for (int split = 0; split < 2; split++) {
+        startEffect(name, split);
+        processCommand("CMD:LOOPCACHE=OFF");   // time the render, not a replay
+        ns[split] = benchNs(400, renderTick);
+        processCommand("CMD:LOOPCACHE=ON");
+      }
+      printf("  %-12s %5u LEDs  inline %8.0f ns  split %8.0f ns  x%.2f\n",
+             name, len, ns[0], ns[1], ns[0] / ns[1]);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  outputConfig[0].leds = STRIP_MAX_LEDS;
+  setup();
+  CHECK_EQ(numLeds, STRIP_MAX_LEDS);
+  CHECK(parStarted);
+  CHECK(!parEnabled);                 // off until measured on the install
+  loopCacheEnabled = false;           // every tick renders
+  testMatchesInline(1200);
+  testMatchesInline(STRIP_MAX_LEDS);
+  testInlineCases();
+  loopCacheEnabled = true;
+  if (argc > 1 && !strcmp(argv[1], "--bench")) bench();
+  int rc = checkDone("parallel");
+  fflush(stdout);
+  _exit(rc);                          // worker threads never end
+}
@@ -0,0 +1,135 @@
+// pixelkernels.h: the scalar reference, SWAR and SSE2 bodies must agree byte
+// for byte on random and edge-case pixels, every tail length and unaligned
+// buffers; then a micro-benchmark of each path.
+#include "Arduino.h"
+#include "../fastrand.h"
+#include "../pixelkernels.h"
+#include "check.h"
+#include <vector>
+
+#define MAXN 4100
+
+struct Path {
+  const char* name;
+  void (*scale)(uint32_t*, const uint32_t*, uint16_t, uint8_t);
+  void (*scaleEach)(uint32_t*, const uint32_t*, const uint8_t*, uint16_t);
+  void (*lerp)(uint32_t*, const uint32_t*, const uint32_t*, uint16_t, uint16_t);
+  void (*addSat)(uint32_t*, const uint32_t*, uint16_t);
+  void (*fadeSub)(uint32_t*, uint16_t, uint8_t, uint8_t, uint8_t);
+};
+
+const Path PATHS[] = {
+  { "scalar", pkScalarScale, pkScalarScaleEach, pkScalarLerp, pkScalarAddSat, pkScalarFadeSub },
+  { "swar",   pkSwarScale,   pkSwarScaleEach,   pkSwarLerp,   pkSwarAddSat,   pkSwarFadeSub },
+#if defined(PK_PATH_SSE2)
+  { "sse2",   pkSse2Scale,   pkSse2ScaleEach,   pkSse2Lerp,   pkSse2AddSat,   pkSse2FadeSub },
+#endif
+};
+const int PATH_COUNT = sizeof(PATHS) / sizeof(PATHS[0]);
+
+// Random 0x00RRGGBB with the channel extremes (0, 1, 127, 128, 254, 255) mixed in
+uint32_t edgePixel() {
+  static const uint8_t edges[] = { 0, 1, 127, 128, 254, 255 };
+  uint32_t r = rngNext();
+  auto ch = [&](int shift) -> uint32_t {
+    return (r >> (shift + 8)) & 1 ? edges[(r >> shift) % 6] : (r >> shift) & 0xFF;
+  };
+  return (ch(0) << 16) | (ch(8) << 8) | ch(16);
+}
+
+std::vector<uint32_t> a(MAXN + 4), b(MAXN + 4), out[3];
+std::vector<uint8_t> levels(MAXN + 4);
+
+void fill() {
+  for (auto& p : a) p = edgePixel();
+  for (auto& p : b) p = edgePixel();
+  for (auto& l : levels) l = (rngNext() & 3) ? rngNext() : ((rngNext() & 1) ? 255 : 0);
+}
+
+// Run op on every path at offset off / length n and compare against scalar
+template <typename Op>
+void compare(const char* what, uint16_t off, uint16_t n, Op op) {
+  for (int p = 0; p < PATH_COUNT; p++) {
+    out[p].assign(a.size(), 0xDEADBEEF);
+    op(PATHS[p], out[p].data() + off, off, n);
+  }
+  for (int p = 1; p < PATH_COUNT; p++) {
+    bool same = out[p] == out[0];
+    if (!same) fprintf(stderr, "  %s differs on %s (off %u, n %u)\n", PATHS[p].name, what, off, n);
+    CHECK(same);
+  }
+}
+
+void testEquivalence() {
+  const uint16_t lens[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 300, MAXN };
+  const uint8_t levelSet[] = { 0, 1, 127, 128, 254, 255 };
+  const uint16_t kSet[] = { 0, 1, 128, 255, 256 };
+  for (int round = 0; round < 8; round++) {
+    fill();
+    for (uint16_t n : lens) {
+      for (uint16_t off = 0; off < 4; off++) {   // unaligned starts for the 16-byte loads
+        for (uint8_t lv : levelSet)
+          compare("scale", off, n, [&](const Path& p, uint32_t* d, uint16_t o, uint16_t m) { p.scale(d, &a[o], m, lv); });
+        compare("scaleEach", off, n, [&](const Path& p, uint32_t* d, uint16_t o, uint16_t m) { p.scaleEach(d, &a[o], &levels[o], m); });
+        for (uint16_t k : kSet)
+          compare("lerp", off, n, [&](const Path& p, uint32_t* d, uint16_t o, uint16_t m) { p.lerp(d, &a[o], &b[o], m, k); });
+        compare("addSat", off, n, [&](const Path& p, uint32_t* d, uint16_t o, uint16_t m) {
+          memcpy(d, &a[o], m * sizeof(uint32_t));
+          p.addSat(d, &b[o], m);
+        });
+        for (uint8_t f : levelSet)
+          compare("fadeSub", off, n, [&](const Path& p, uint32_t* d, uint16_t o, uint16_t m) {
+            memcpy(d, &a[o], m * sizeof(uint32_t));
+            p.fadeSub(d, m, f, 255 - f, f / 2);
+          });
+      }
+    }
+  }
+
+  // The public names and the single-pixel forms match the reference too
+  fill();
+  std::vector<uint32_t> ref(300), got(300);
+  pkScalarLerp(ref.data(), a.data(), b.data(), 300, 77);
+  pkLerp(got.data(), a.data(), b.data(), 300, 77);
+  CHECK(ref == got);
+  for (int i = 0; i < 300; i++) {
+    uint32_t r1;
+    pkScalarScale(&r1, &a[i], 1, levels[i]);
+    CHECK_EQ(pkSwarScale1(a[i], levels[i] + 1), r1);
+    pkScalarLerp(&r1, &a[i], &b[i], 1, levels[i]);
+    CHECK_EQ(pkSwarLerp1(a[i], b[i], levels[i]), r1);
+    r1 = a[i];
+    pkScalarAddSat(&r1, &b[i], 1);
+    CHECK_EQ(pkSwarAddSat1(a[i], b[i]), r1);
+  }
+}
+
+void bench() {
+  const uint16_t sizes[] = { 300, 4096 };
+  fill();
+  std::vector<uint32_t> d(MAXN);
+  volatile uint32_t sink = 0;
+  for (uint16_t n : sizes) {
+    printf("  n=%-5u        scale  scaleEach     lerp   addSat  fadeSub   (ns/pixel)\n", n);
+    int reps = 2000000 / n;
+    for (int p = 0; p < PATH_COUNT; p++) {
+      const Path& P = PATHS[p];
+      double t[5];
+      t[0] = benchNs(reps, [&] { P.scale(d.data(), a.data(), n, 100); sink += d[3]; });
+      t[1] = benchNs(reps, [&] { P.scaleEach(d.data(), a.data(), levels.data(), n); sink += d[3]; });
+      t[2] = benchNs(reps, [&] { P.lerp(d.data(), a.data(), b.data(), n, 100); sink += d[3]; });
+      t[3] = benchNs(reps, [&] { P.addSat(d.data(), b.data(), n); sink += d[3]; });
+      t[4] = benchNs(reps, [&] { P.fadeSub(d.data(), n, 3, 3, 3); sink += d[3]; });
+      printf("  %-8s", P.name);
+      for (double x : t) printf(" %9.3f", x / n);
+      printf("\n");
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  rngSeed(2024);
+  testEquivalence();
+  if (argc > 1 && !strcmp(argv[1], "--bench")) bench();
+  return checkDone("pixelkernels");
+}
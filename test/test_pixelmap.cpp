@@ -0,0 +1,106 @@
+// pixelmap.h: logical pixels landing on several outputs (NeoPixel
+// stand-ins), reversed runs, gaps, and only touched outputs shown
+#include "host.h"
+
+// Three outputs, as a saved config would have them at boot:
+//   logical  0..29  → out 0 @ 0..29
+//   logical 30..49  → out 1 @ 29..10 (reversed; 0..9 is a gap)
+//   logical 50..69  → out 2 @ 0..19
+//   logical 70..79  → out 1 @ 30..39, two serpentine rows of 5
+static void configure() {
+  outputConfig[0] = { 30, 2, NEO_GRB };
+  outputConfig[1] = { 40, 5, NEO_GRB };
+  outputConfig[2] = { 20, 4, NEO_RGB };
+  mapRunCount = 0;
+  mapAppend(mapRuns, mapRunCount, 0, 0, 30, false);
+  mapAppend(mapRuns, mapRunCount, 1, 10, 20, true);
+  mapAppend(mapRuns, mapRunCount, 2, 0, 20, false);
+  mapSerpentine(mapRuns, mapRunCount, 1, 5, 2, 30);
+}
+
+struct Phys { uint8_t out; uint16_t p; };
+
+// Where logical i should land, by hand
+static Phys expected(uint16_t i) {
+  if (i < 30) return { 0, i };
+  if (i < 50) return { 1, (uint16_t)(29 - (i - 30)) };
+  if (i < 70) return { 2, (uint16_t)(i - 50) };
+  if (i < 75) return { 1, (uint16_t)(30 + (i - 70)) };
+  return { 1, (uint16_t)(39 - (i - 75)) };
+}
+
+static uint32_t shade(uint16_t i) { return ((uint32_t)(i + 1) << 16) | ((uint32_t)(i * 3) << 8) | (i ^ 0x5A); }
+
+static void testLayout() {
+  CHECK_EQ(numLeds, 80);
+  CHECK_EQ(outputs[0]->numPixels(), 30);
+  CHECK_EQ(outputs[1]->numPixels(), 40);
+  CHECK_EQ(outputs[2]->numPixels(), 20);
+  CHECK_EQ(outputs[3]->numPixels(), 0);
+  CHECK_EQ(outputs[1]->pin, 5);
+
+  for (uint16_t i = 0; i < numLeds; i++) setPixel(i, shade(i));
+  commitFrame();
+  for (uint16_t i = 0; i < numLeds; i++) {
+    Phys e = expected(i);
+    CHECK_EQ(outputs[e.out]->px[e.p], outputPixel(i));
+    CHECK(outputPixel(i) != 0);
+  }
+  for (uint16_t p = 0; p < 10; p++) CHECK_EQ(outputs[1]->px[p], 0);   // gap stays dark
+}
+
+// A change inside one output shows that output only
+static void testTouchedOnly() {
+  unsigned before[PIXMAP_MAX_OUTPUTS];
+  for (uint8_t o = 0; o < PIXMAP_MAX_OUTPUTS; o++) before[o] = outputs[o]->shows;
+
+  setPixel(55, 0x102030);
+  commitFrame();
+  CHECK_EQ(outputs[0]->shows, before[0]);
+  CHECK_EQ(outputs[1]->shows, before[1]);
+  CHECK_EQ(outputs[2]->shows, before[2] + 1);
+  CHECK_EQ(outputs[2]->px[5], outputPixel(55));
+
+  // Spanning a run boundary reaches both outputs
+  setPixel(29, 0x010203);
+  setPixel(30, 0x040506);
+  commitFrame();
+  CHECK_EQ(outputs[0]->shows, before[0] + 1);
+  CHECK_EQ(outputs[1]->shows, before[1] + 1);
+  CHECK_EQ(outputs[2]->shows, before[2] + 1);
+  CHECK_EQ(outputs[0]->px[29], outputPixel(29));
+  CHECK_EQ(outputs[1]->px[29], outputPixel(30));
+
+  // Nothing dirty, nothing shown
+  commitFrame();
+  CHECK_EQ(outputs[0]->shows, before[0] + 1);
+  CHECK_EQ(outputs[2]->shows, before[2] + 1);
+}
+
+static void testValidation() {
+  uint16_t lens[PIXMAP_MAX_OUTPUTS];
+  outputLengths(lens);
+  CHECK(mapValid(mapRuns, mapRunCount, lens, STRIP_MAX_LEDS));
+  CHECK(!mapValid(mapRuns, mapRunCount, lens, 79));         // longer than allowed
+
+  MapRun runs[PIXMAP_MAX_RUNS] = {};
+  uint8_t count = 0;
+  CHECK(!mapValid(runs, count, lens, STRIP_MAX_LEDS));      // empty
+  mapAppend(runs, count, 2, 10, 11, false);                 // one past the end of out 2
+  CHECK(!mapValid(runs, count, lens, STRIP_MAX_LEDS));
+  count = 0;
+  mapAppend(runs, count, 3, 0, 1, false);                   // output off
+  CHECK(!mapValid(runs, count, lens, STRIP_MAX_LEDS));
+  CHECK(!mapAppend(runs, count, 0, 0, 0, false));           // zero-length run
+  while (count < PIXMAP_MAX_RUNS) mapAppend(runs, count, 0, 0, 1, false);
+  CHECK(!mapAppend(runs, count, 0, 0, 1, false));           // list full
+}
+
+int main() {
+  configure();
+  setup();
+  testLayout();
+  testTouchedOnly();
+  testValidation();
+  return checkDone("pixelmap");
+}
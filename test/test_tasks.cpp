@@ -0,0 +1,108 @@
+// taskqueue.h / tasks.h / idle.h under ThreadSanitizer: the SPSC rings,
+// statusShow() routing between the render and UI tasks, and the idle
+// wake handshake (idleRxStamp), with the UI task on its own thread as on
+// the ESP32. Built and run by `make tsan` (-DDUAL_CORE=1 -fsanitize=thread);
+// any race TSan sees fails the run.
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+#include "host.h"
+
+#if !DUAL_CORE
+#error "test_tasks needs -DDUAL_CORE=1 (make tsan)"
+#endif
+
+// Keep calling loop() on this (the render) thread until done() or ms pass
+template <typename F>
+static bool loopUntil(F&& done, unsigned long ms) {
+  unsigned long t0 = millis();
+  while (!done()) {
+    if (millis() - t0 > ms) return false;
+    loop();
+  }
+  return true;
+}
+
+// One producer, one consumer, a ring much smaller than the traffic: every
+// value arrives once, in order, with its payload intact
+static void testRingOrder() {
+  static SpscRing<UiMsg, UI_RING_SIZE> ring;
+  const uint32_t N = 100000;
+  std::thread producer([&] {
+    UiMsg m;
+    m.kind = UI_STATUS;
+    for (uint32_t v = 1; v <= N;) {
+      m.ms = v & 0xFFFF;
+      snprintf(m.text, sizeof(m.text), "msg %u", (unsigned)v);
+      if (ring.push(m)) v++;
+      else std::this_thread::yield();
+    }
+  });
+
+  uint32_t want = 1, bad = 0;
+  char expect[UI_TEXT_MAX];
+  while (want <= N) {
+    UiMsg m;
+    if (!ring.pop(m)) { std::this_thread::yield(); continue; }
+    snprintf(expect, sizeof(expect), "msg %u", (unsigned)want);
+    if (m.ms != (want & 0xFFFF) || strcmp(m.text, expect)) bad++;
+    want++;
+  }
+  producer.join();
+  CHECK_EQ(bad, 0);
+  CHECK(ring.empty());
+}
+
+// Render-side statusShow()/lcdMessage() post; the UI task draws them
+static void testStatusRouting() {
+  CHECK(!onUiTask());
+  for (int i = 0; i < UI_RING_SIZE - 1; i++) {
+    statusShow("Render " + String(i), 900);
+    lcdMessage("lcd " + String(i));
+  }
+  statusShow("Last", 900);
+  unsigned long t0 = millis();
+  while (!uiRing.empty() && millis() - t0 < 2000) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  CHECK(uiRing.empty());
+}
+
+// Serial line → UI task → cmdRing → render task, status back the other way
+static void testCommandPath() {
+  Serial.feed("CMD:BRIGHTNESS=37");
+  CHECK(loopUntil([] { return brightnessPct == 37; }, 2000));
+  for (int i = 0; i < 40; i++) Serial.feed("CMD:SPEED=" + std::to_string(50 + i));
+  CHECK(loopUntil([] { return cmdRing.empty() && uiRing.empty(); }, 3000));
+}
+
+// Static scene: the render task sleeps; a line arriving from the UART
+// (UI task: queue + idleOnReceive) wakes it and the latency is counted
+static void testIdleWake() {
+  idleEnabled = true;
+  CHECK(loopUntil([] { return idleSceneStatic(); }, 2000));
+  idleSince = millis() - IDLE_ENTER_MS;
+  CHECK(loopUntil([] { return idling; }, 2000));
+
+  uint32_t wakes = idleWakes;
+  std::thread uart([] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    Serial.feed("CMD:BRIGHTNESS=55");
+  });
+  CHECK(loopUntil([] { return brightnessPct == 55; }, 2000));
+  uart.join();
+  CHECK(!idling);
+  CHECK_EQ(idleWakes, wakes + 1);
+  CHECK(idleWakeLastUs > 0 && idleWakeLastUs < 500000);
+  CHECK_EQ(idleRxStamp.load(), 0);
+}
+
+int main() {
+  hostRealClock = true;
+  testRingOrder();
+  setup();              // tasksBegin(): the UI task thread runs from here on
+  testStatusRouting();
+  testCommandPath();
+  testIdleWake();
+  int rc = checkDone("tasks");
+  fflush(stdout);
+  _exit(rc);            // the UI thread never ends; skip static destructors under it
+}
@@ -0,0 +1,58 @@
+#pragma once
+// =====================
+// 🌫 TRANSITION MODULE
+// =====================
+//
+// Crossfade between scenes. When a scene-changing command arrives (effect,
+// color, pattern, mood, LED on/off), transitionBegin() keeps the outgoing
+// picture in fadeFrom[]; the new scene renders into frame[] as usual, and
+// commitFrame() sends a fixed-point lerp of the two for fadeMs.
+//
+// Nothing in frame[] is touched, so effects keep animating underneath the
+// fade. A command arriving mid-fade starts from the blend on the LEDs right
+// now instead of jumping. Steps are paced to TRANSITION_STEP_MS so a fade
+// never pushes frames faster than the strip can show them.
+//
+// CMD:FADE=ms (0 = instant cut, the default).
+//
+
+#define TRANSITION_STEP_MS 16      // ≈60 fps while fading
+
+uint16_t fadeMs = 0;
+uint32_t* fadeFrom;                // outgoing picture (logical, unscaled), numLeds
+bool transitionActive = false;
+uint16_t transitionK = 256;        // weight of the incoming frame, 0..256
+unsigned long transitionStart = 0;
+unsigned long transitionLastStep = 0;
+
+// Logical pixel as it should leave the output stage this frame
+inline uint32_t transitionPixel(uint16_t i) {
+  uint32_t c = logicalPixel(i);
+  return transitionActive ? lerpColor(fadeFrom[i], c, transitionK) : c;
+}
+
+void transitionBegin() {
+  if (!fadeMs) return;
+  for (uint16_t i = 0; i < numLeds; i++) fadeFrom[i] = transitionPixel(i);
+  transitionActive = true;
+  transitionK = 0;
+  transitionStart = transitionLastStep = millis();
+}
+
+// Called from commitFrame(): advance the blend, dirtying the strip at most
+// once per TRANSITION_STEP_MS
+void transitionStep() {
+  if (!transitionActive) return;
+  unsigned long now = millis();
+  unsigned long t = now - transitionStart;
+  if (t >= fadeMs) {
+    transitionActive = false;
+    transitionK = 256;
+    markAllDirty();          // one last push of the clean incoming frame
+    return;
+  }
+  if (now - transitionLastStep < TRANSITION_STEP_MS) return;
+  transitionLastStep = now;
+  transitionK = (uint16_t)(t * 256 / fadeMs);
+  markAllDirty();
+}
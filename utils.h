@@ -13,17 +13,15 @@ extern uint32_t compositeColor2;
 void fillAll(uint32_t col) {
   if (compositeMode) {
     // Alternate between the two composite colors
-    for (uint16_t i = ledStart; i <= ledEnd && i < NUM_LEDS; i++) {
-      if (i % 2 == 0) strip.setPixelColor(i, compositeColor1);
-      else strip.setPixelColor(i, compositeColor2);
+    for (uint16_t i = ledStart; i <= ledEnd && i < numLeds; i++) {
+      if (i % 2 == 0) setPixel(i, compositeColor1);
+      else setPixel(i, compositeColor2);
     }
-    strip.show();
   } else {
     // Fill with a single color
-    for (uint16_t i = ledStart; i <= ledEnd && i < NUM_LEDS; i++) {
-      strip.setPixelColor(i, col);
+    for (uint16_t i = ledStart; i <= ledEnd && i < numLeds; i++) {
+      setPixel(i, col);
     }
-    strip.show();
   }
 }
 
@@ -94,7 +92,7 @@ uint32_t parseColor(String n) {
 
   // 🚨 Unknown Color Handling
   Serial.println("❗ Unknown color: " + n);
-  lcd.clear(); lcd.print("❌ Unknown color");
+  lcdMessage("❌ Unknown color");
   return strip.Color(255, 255, 255);
 }
 
@@ -0,0 +1,324 @@
+#pragma once
+// =====================
+// 🗺 ZONES MODULE
+// =====================
+//
+// Up to MAX_ZONES extra LED segments, each with its own effect, speed,
+// colors/palette and brightness, rendered in the same loop pass as the main
+// strip and pushed by the same commitFrame().
+//
+//   CMD:ZONE=<n>,<start>,<end>   define (or redefine) zone n (1..MAX_ZONES)
+//   CMD:ZONE=<n>,OFF             remove zone n
+//   CMD:ZONE=OFF                 remove all zones
+//   CMD:ZONE=LIST                print the zone table
+//   CMD@<n>:<command>            run any strip command inside zone n,
+//                                e.g. CMD@1:EFFECT=pulse, CMD@2:RAIN=heavy
+//
+// The main strip keeps its state in globals (ledStart/ledEnd, currentEffect,
+// multiColors, ...). A zone holds its own copy of every one of them, and
+// zoneEnter() swaps the two sets so the existing effects, patterns and
+// command handlers work unchanged inside a zone; zoneLeave() swaps back.
+// Per-effect counters (EffectState), the palette table and the wave base
+// are swapped by pointer, particles by context tag (particles.h).
+//
+// Zones must not overlap each other. The main strip's range should leave
+// them out (CMD:LEDRANGE), otherwise its effect draws under them.
+//
+
+#define MAX_ZONES 4
+
+// from commands.h
+String effectName(EffectType e);
+
+struct Zone {
+  bool used;
+  uint8_t level;                 // zone brightness (CMD@n:BRIGHTNESS)
+  uint8_t fxLevel;               // PULSE/SOFT_GLOW dimming inside the zone
+
+  // --- swapped with the main-strip globals by zoneSwapContext() ---
+  uint16_t ledStart, ledEnd, activeLEDCount;
+  uint32_t currentColor;
+  EffectType currentEffect, lastEffect;
+  unsigned long lastMillis;
+  uint16_t effectSpeed;
+  bool customSpeed;
+  uint16_t waveIndex, blinkCount, blinkCounter, chaseIndex, chaseRep;
+  bool blinkOn, strobeOn;
+  uint16_t strobeCount, centerIndex;
+  uint8_t pulseBrightness;
+  bool pulseUp, bounceForward, thunderState;
+  uint16_t fadeHue, rainbowHue;
+  String rainMode;
+  uint8_t rainIntensity;
+  bool shimmerActive;
+  uint8_t cometCount;
+  bool compositeMode;
+  uint32_t compositeColor1, compositeColor2;
+  String basePattern;
+  bool scrollMode;
+  IndexedBase* scrollBase;
+  int scrollBaseLen;
+  bool scrollBaseCaptured;
+  ScrollView scrollView;
+  uint8_t multiColors[MAX_MULTI_COLORS][3];
+  int multiColorCount;
+  uint8_t multiStopPos[MAX_MULTI_COLORS];
+  bool multiStopPosSet;
+  Palette* activePalette;
+  EffectState* fx;
+  uint8_t particleContext;
+  uint8_t* effectLevelSink;
+
+  // --- owned storage the pointers above start out at ---
+  Palette palette;
+  EffectState state;
+  IndexedBase base;              // wave base, indices in zoneBaseStore
+};
+
+Zone zones[MAX_ZONES];
+uint8_t zoneCount = 0;
+int8_t zoneActive = -1;            // zone whose context is swapped in, -1 = main strip
+bool zoneEffectsRunning = false;   // any zone animating (read by layers.h)
+
+uint8_t* zoneBaseStore;            // numLeds wave base indices, sliced by absolute index (zones never overlap)
+uint8_t mainFxLevel = 255;         // main strip effect dimming while zones exist
+
+// ======================
+// 🔁 CONTEXT SWAP
+// ======================
+template <typename T>
+inline void zoneSwap(T& a, T& b) { T t = a; a = b; b = t; }
+
+void zoneSwapContext(Zone& z) {
+#define ZSWAP(f) zoneSwap(z.f, ::f)
+  ZSWAP(ledStart); ZSWAP(ledEnd); ZSWAP(activeLEDCount);
+  ZSWAP(currentColor);
+  ZSWAP(currentEffect); ZSWAP(lastEffect);
+  ZSWAP(lastMillis); ZSWAP(effectSpeed); ZSWAP(customSpeed);
+  ZSWAP(waveIndex); ZSWAP(blinkCount); ZSWAP(blinkCounter); ZSWAP(chaseIndex); ZSWAP(chaseRep);
+  ZSWAP(blinkOn); ZSWAP(strobeOn); ZSWAP(strobeCount); ZSWAP(centerIndex);
+  ZSWAP(pulseBrightness); ZSWAP(pulseUp); ZSWAP(bounceForward); ZSWAP(thunderState);
+  ZSWAP(fadeHue); ZSWAP(rainbowHue);
+  ZSWAP(rainMode); ZSWAP(rainIntensity);
+  ZSWAP(shimmerActive); ZSWAP(cometCount);
+  ZSWAP(compositeMode); ZSWAP(compositeColor1); ZSWAP(compositeColor2);
+  ZSWAP(basePattern); ZSWAP(scrollMode);
+  ZSWAP(scrollBase); ZSWAP(scrollBaseLen); ZSWAP(scrollBaseCaptured); ZSWAP(scrollView);
+  ZSWAP(multiColorCount); ZSWAP(multiStopPosSet);
+  ZSWAP(activePalette); ZSWAP(fx); ZSWAP(particleContext); ZSWAP(effectLevelSink);
+#undef ZSWAP
+  for (uint8_t i = 0; i < MAX_MULTI_COLORS; i++) {
+    for (uint8_t c = 0; c < 3; c++) zoneSwap(z.multiColors[i][c], ::multiColors[i][c]);
+    zoneSwap(z.multiStopPos[i], ::multiStopPos[i]);
+  }
+}
+
+inline bool zoneValid(int n) {
+  return n >= 1 && n <= MAX_ZONES && zones[n - 1].used;
+}
+
+inline void zoneEnter(uint8_t n) {
+  zoneSwapContext(zones[n - 1]);
+  zoneActive = n - 1;
+}
+
+inline void zoneLeave() {
+  if (zoneActive < 0) return;
+  zoneSwapContext(zones[zoneActive]);
+  zoneActive = -1;
+}
+
+// ======================
+// 🗂 ZONE TABLE
+// ======================
+// First zone: main-strip effect dimming moves from the output tables to an
+// output span, so it stops dimming the zones too. Last zone: back again.
+void zonesRouteMainLevel(bool toSpan) {
+  if (toSpan) {
+    mainFxLevel = effectLevel;
+    effectLevel = 255;
+    effectLevelSink = &mainFxLevel;
+  } else {
+    effectLevelSink = nullptr;
+    effectLevel = mainFxLevel;
+    mainFxLevel = 255;
+  }
+  invalidateOutputStage();
+}
+
+void zoneRemove(uint8_t n) {
+  if (!zoneValid(n)) return;
+  zoneEnter(n);
+  particlesReset();
+  clearRange(ledStart, ledEnd);
+  loopCacheFree(fx->loop);
+  indexedDropRgb(*scrollBase);
+  zoneLeave();
+  zones[n - 1].used = false;
+  if (--zoneCount == 0) zonesRouteMainLevel(false);
+}
+
+// Returns false if the range is invalid or overlaps another zone
+bool zoneDefine(uint8_t n, uint16_t start, uint16_t end) {
+  if (n < 1 || n > MAX_ZONES || start > end || end >= numLeds) return false;
+  for (uint8_t k = 1; k <= MAX_ZONES; k++) {
+    if (k == n || !zones[k - 1].used) continue;
+    if (start <= zones[k - 1].ledEnd && end >= zones[k - 1].ledStart) return false;
+  }
+  zoneRemove(n);   // redefining starts fresh
+
+  Zone& z = zones[n - 1];
+  z.used = true;
+  z.level = 255;
+  z.fxLevel = 255;
+  z.ledStart = start;
+  z.ledEnd = end;
+  z.activeLEDCount = end - start + 1;
+  z.currentColor = strip.Color(255, 255, 255);
+  z.currentEffect = NONE;
+  z.lastEffect = NONE;
+  z.lastMillis = 0;
+  z.effectSpeed = 100;
+  z.customSpeed = false;
+  z.waveIndex = z.blinkCount = z.blinkCounter = z.chaseIndex = z.chaseRep = 0;
+  z.blinkOn = z.strobeOn = false;
+  z.strobeCount = z.centerIndex = 0;
+  z.pulseBrightness = 0;
+  z.pulseUp = z.bounceForward = z.thunderState = true;
+  z.fadeHue = z.rainbowHue = 0;
+  z.rainMode = "medium";
+  z.rainIntensity = 3;
+  z.shimmerActive = false;
+  z.cometCount = 1;
+  z.compositeMode = false;
+  z.compositeColor1 = z.compositeColor2 = 0;
+  z.basePattern = "";
+  z.scrollMode = false;
+  z.base = IndexedBase();
+  z.base.idx = &zoneBaseStore[start];
+  z.scrollBase = &z.base;
+  z.scrollBaseLen = 0;
+  z.scrollBaseCaptured = false;
+  z.scrollView = { false, 0, 0, 0 };
+  memset(z.multiColors, 0, sizeof(z.multiColors));
+  z.multiColorCount = 0;
+  memset(z.multiStopPos, 0, sizeof(z.multiStopPos));
+  z.multiStopPosSet = false;
+  paletteBuild(z.palette, z.multiColors, nullptr, 0);
+  z.activePalette = &z.palette;
+  z.state = EffectState();
+  z.fx = &z.state;
+  z.particleContext = n;
+  z.effectLevelSink = &z.fxLevel;
+
+  if (zoneCount++ == 0) zonesRouteMainLevel(true);
+  return true;
+}
+
+// Black out [from..to] except pixels a zone owns: moving the main range
+// must not blank a zone until its next redraw
+void clearOutsideZones(uint16_t from, uint16_t to) {
+  if (to >= numLeds) to = numLeds - 1;
+  uint16_t i = from;
+  while (i <= to) {
+    uint16_t end = to;
+    bool owned = false;
+    for (uint8_t k = 0; k < MAX_ZONES; k++) {
+      const Zone& z = zones[k];
+      if (!z.used) continue;
+      if (i >= z.ledStart && i <= z.ledEnd) {
+        i = z.ledEnd + 1;
+        owned = true;
+        break;
+      }
+      if (z.ledStart > i && z.ledStart <= end) end = z.ledStart - 1;
+    }
+    if (owned) continue;
+    clearRange(i, end);
+    i = end + 1;
+  }
+}
+
+// A palette table is about to be rebuilt (palette.h): the wave/scroll bases
+// still indexing into it take an RGB copy, a base cache built on it goes
+void paletteRetireLut(const uint32_t* lut) {
+  bool ok = indexedDetach(scrollBaseStore, lut);
+  for (uint8_t k = 0; k < MAX_ZONES; k++) {
+    if (zones[k].used) ok &= indexedDetach(zones[k].base, lut);
+  }
+  if (baseCache.lut == lut) baseCacheValid = false;
+  if (!ok) Serial.println("⚠️ Wave base approximated: no RAM for an exact copy");
+}
+
+// Main-strip redrawBase() that leaves the zones it overlaps showing what
+// they showed (a static zone would otherwise stay painted over)
+void mainRedrawBase() {
+  uint32_t* keep[MAX_ZONES] = {};
+  for (uint8_t k = 0; k < MAX_ZONES; k++) {
+    const Zone& z = zones[k];
+    if (!z.used || z.ledStart > ledEnd || z.ledEnd < ledStart) continue;
+    uint16_t n = z.ledEnd - z.ledStart + 1;
+    keep[k] = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (keep[k]) memcpy(keep[k], &drawTarget[z.ledStart], n * sizeof(uint32_t));
+  }
+  redrawBase();
+  for (uint8_t k = 0; k < MAX_ZONES; k++) {
+    if (!keep[k]) continue;
+    uint16_t n = zones[k].ledEnd - zones[k].ledStart + 1;
+    memcpy(drawRange(zones[k].ledStart, n), keep[k], n * sizeof(uint32_t));
+    free(keep[k]);
+  }
+}
+
+void zonesClear() {
+  for (uint8_t n = 1; n <= MAX_ZONES; n++) zoneRemove(n);
+}
+
+void zonesPrint() {
+  Serial.print("🗺 Zones: "); Serial.println(zoneCount);
+  for (uint8_t n = 1; n <= MAX_ZONES; n++) {
+    const Zone& z = zones[n - 1];
+    if (!z.used) continue;
+    Serial.print("  #"); Serial.print(n);
+    Serial.print(" "); Serial.print(z.ledStart); Serial.print("-"); Serial.print(z.ledEnd);
+    Serial.print(" effect="); Serial.print(effectName(z.currentEffect));
+    Serial.print(" speed="); Serial.print(z.effectSpeed);
+    Serial.print(" level="); Serial.println(z.level);
+  }
+}
+
+// Zone brightness (CMD@n:BRIGHTNESS=0-100) instead of the global one
+void zoneSetBrightness(uint8_t pct) {
+  if (zoneActive < 0) return;
+  zones[zoneActive].level = map(pct, 0, 100, 0, 255);
+  markDirty(ledStart, ledEnd);
+}
+
+// ======================
+// 🔄 LOOP RENDERER (after the main effect, before commitFrame)
+// ======================
+void renderZones() {
+  zoneEffectsRunning = false;
+  if (zoneCount == 0) {
+    outputSpanCount = 0;
+    return;
+  }
+
+  uint8_t spans = 0;
+  for (uint8_t n = 1; n <= MAX_ZONES; n++) {
+    Zone& z = zones[n - 1];
+    if (!z.used) continue;
+    if (z.currentEffect != NONE) {
+      zoneEffectsRunning = true;
+      zoneEnter(n);
+      runCurrentEffect();
+      zoneLeave();
+    }
+    // Always listed, and ahead of the main span: outputPixel() takes the
+    // first match, so main-strip dimming never reaches a zone's pixels
+    uint8_t lvl = (z.level * (z.fxLevel + 1)) >> 8;
+    if (spans < MAX_OUTPUT_SPANS) outputSpans[spans++] = { z.ledStart, z.ledEnd, lvl };
+  }
+  if (mainFxLevel < 255 && spans < MAX_OUTPUT_SPANS) outputSpans[spans++] = { ledStart, ledEnd, mainFxLevel };
+  outputSpanCount = spans;
+}